@@ -1,6 +1,7 @@
 #include "SGMEntityFunctions.h"
 #include "SGMTriangle.h"
 #include "SGMGraph.h"
+#include "SGMBoxTree.h"
 
 #include "EntityClasses.h"
 #include "Curve.h"
@@ -9,8 +10,15 @@
 #include "Primitive.h"
 #include "Query.h"
 
+#include <algorithm>
 #include <sstream>
 
+#ifdef SGM_MULTITHREADED
+#include "SGMThreadPool.h"
+#include <future>
+#include <thread>
+#endif
+
 namespace SGMInternal
 {
 
@@ -21,19 +29,146 @@ inline std::ostream& operator<<(std::ostream& out, const entity *pEntity)
     return out << SGM::EntityTypeName(pEntity->GetType()) << " " << pEntity->GetID();
     }
 
+#ifdef SGM_MULTITHREADED
+
+// Finds the lazily computed data that the checks read and that is not found
+// by thing::FindCachedData, so that entities can be checked concurrently.
+
+struct CheckCacheVisitor : EntityVisitor
+    {
+    CheckCacheVisitor() = delete;
+
+    explicit CheckCacheVisitor(SGM::Result &rResult) : EntityVisitor(rResult)
+        {}
+
+    template<class GEOMETRY>
+    static void FindSeeds(GEOMETRY const &g)
+        {
+        g.GetSeedPoints();
+        }
+
+    inline void Visit(NUBcurve &c) override { FindSeeds(c); }
+    inline void Visit(NURBcurve &c) override { FindSeeds(c); }
+    inline void Visit(TorusKnot &c) override { FindSeeds(c); }
+    inline void Visit(hermite &c) override { FindSeeds(c); }
+    inline void Visit(torus &s) override { FindSeeds(s); }
+    inline void Visit(NUBsurface &s) override { FindSeeds(s); }
+    inline void Visit(NURBsurface &s) override { FindSeeds(s); }
+
+    inline void Visit(face &f) override
+        {
+        f.GetVertices();
+        f.GetTriangles(*pResult);
+        f.GetBox(*pResult);
+        }
+
+    inline void Visit(edge &e) override { e.GetBox(*pResult); }
+    inline void Visit(volume &v) override { v.GetBox(*pResult); }
+    };
+
+// Checks aEntities[nStart,nEnd) with a Result of its own, so that the
+// Result of the caller is not shared between threads.
+
+static SGM::ResultType CheckEntityRange(thing                     *pThing,
+                                        std::vector<entity *> const &aEntities,
+                                        size_t                      nStart,
+                                        size_t                      nEnd,
+                                        SGM::CheckOptions    const &Options,
+                                        std::vector<std::vector<std::string> > &aaCheckStrings,
+                                        std::vector<char>          &aChecked)
+    {
+    SGM::Result rJobResult(pThing);
+    for(size_t Index1=nStart;Index1<nEnd;++Index1)
+        {
+        aChecked[Index1]=aEntities[Index1]->Check(rJobResult,Options,aaCheckStrings[Index1],false);
+        }
+    return rJobResult.GetResult();
+    }
+
+#endif // SGM_MULTITHREADED
+
+// Checks each of the given entities without their children, and appends
+// their check strings in the order of aEntities.
+
+bool CheckEntities(SGM::Result                 &rResult,
+                   std::vector<entity *> const &aEntities,
+                   SGM::CheckOptions     const &Options,
+                   std::vector<std::string>    &aCheckStrings)
+    {
+    bool bAnswer=true;
+    size_t nEntities=aEntities.size();
+
+#ifdef SGM_MULTITHREADED
+
+    const size_t MIN_PARALLEL_ENTITIES=256, NUM_ENTITY_PER_JOB=64;
+    if(MIN_PARALLEL_ENTITIES<=nEntities)
+        {
+        thing *pThing=rResult.GetThing();
+        pThing->FindCachedData(rResult);
+        CheckCacheVisitor CacheVisitor(rResult);
+        for(auto pEntity : aEntities)
+            {
+            pEntity->Accept(CacheVisitor);
+            }
+
+        std::vector<std::vector<std::string> > aaCheckStrings(nEntities);
+        std::vector<char> aChecked(nEntities,true);
+        unsigned nThreads=std::max(4U,std::thread::hardware_concurrency());
+        SGM::ThreadPool threadPool(nThreads);
+        std::vector<std::future<SGM::ResultType> > aFutures;
+        pThing->SetConcurrentActive();
+        for(size_t nStart=0;nStart<nEntities;nStart+=NUM_ENTITY_PER_JOB)
+            {
+            size_t nEnd=std::min(nStart+NUM_ENTITY_PER_JOB,nEntities);
+            aFutures.emplace_back(threadPool.enqueue(CheckEntityRange,pThing,std::cref(aEntities),nStart,nEnd,
+                                                     std::cref(Options),std::ref(aaCheckStrings),std::ref(aChecked)));
+            }
+        for(auto &Future : aFutures)
+            {
+            SGM::ResultType nType=Future.get();
+            if(nType!=SGM::ResultTypeOK && rResult.GetResult()==SGM::ResultTypeOK)
+                {
+                rResult.SetResult(nType);
+                }
+            }
+        pThing->SetConcurrentInactive();
+
+        for(size_t Index1=0;Index1<nEntities;++Index1)
+            {
+            if(!aChecked[Index1])
+                {
+                bAnswer=false;
+                }
+            std::vector<std::string> &aStrings=aaCheckStrings[Index1];
+            aCheckStrings.insert(aCheckStrings.end(),aStrings.begin(),aStrings.end());
+            }
+        return bAnswer;
+        }
+
+#endif // SGM_MULTITHREADED
+
+    for(size_t Index1=0;Index1<nEntities;++Index1)
+        {
+        if(!aEntities[Index1]->Check(rResult,Options,aCheckStrings,false))
+            {
+            bAnswer=false;
+            }
+        }
+    return bAnswer;
+    }
+
 bool thing::Check(SGM::Result              &rResult,
                   SGM::CheckOptions  const &Options,
                   std::vector<std::string> &aCheckStrings,
                   bool                      ) const
     {
-    bool bAnswer = true;
-
+    std::vector<entity *> aEntities;
+    aEntities.reserve(m_mAllEntities.size());
     for (auto const &iter : m_mAllEntities)
         {
-        if (!iter.second->Check(rResult, Options, aCheckStrings,false))
-            bAnswer = false;
+        aEntities.push_back(iter.second);
         }
-    return bAnswer;
+    return CheckEntities(rResult,aEntities,Options,aCheckStrings);
     }
 
 bool CheckChildren(SGM::Result              &rResult,
@@ -43,15 +178,8 @@ bool CheckChildren(SGM::Result              &rResult,
     {
     std::set<entity *,EntityCompare> sChildren;
     pEntity->FindAllChildren(sChildren);
-    bool bAnswer=true;
-    for(auto pChild : sChildren)
-        {
-        if(pChild->Check(rResult,Options,aCheckStrings,false)==false)
-            {
-            bAnswer=false;
-            }
-        }
-    return bAnswer;
+    std::vector<entity *> aChildren(sChildren.begin(),sChildren.end());
+    return CheckEntities(rResult,aChildren,Options,aCheckStrings);
     }
 
 bool CheckChildHasOwner(entity             const *pChild,
@@ -89,44 +217,26 @@ bool CheckOwnersHaveChild(entity const *pChild, std::vector<std::string> &aCheck
     return bAnswer;
     }
 
-bool EdgesOverlap(edge const *pEdge1,edge const *pEdge2)
-    {
-    // Only check the end points of pEdge1, to see if they overlap.
+// Returns true if pVertex is not a vertex of pEdge but lies on it.
 
-    if(pEdge1->GetStart())
-        {
-        if(pEdge2->GetStart()!=pEdge1->GetStart() && pEdge2->GetStart()!=pEdge1->GetEnd())
-            {
-            SGM::Point3D Pos=pEdge1->GetStart()->GetPoint();
-            SGM::Point3D CPos;
-            double t=pEdge2->GetCurve()->Inverse(Pos,&CPos);
-            if(Pos.Distance(CPos)<SGM_ZERO)
-                {
-                if(pEdge2->GetDomain().InInterval(t,SGM_MIN_TOL))
-                    {
-                    return true;
-                    }
-                }
-            }
-        }
-    if(pEdge2->GetStart())
+bool VertexOnEdge(vertex const *pVertex,edge const *pEdge)
+    {
+    if(pVertex==nullptr || pVertex==pEdge->GetStart() || pVertex==pEdge->GetEnd())
         {
-        if(pEdge1->GetStart()!=pEdge2->GetStart() && pEdge1->GetStart()!=pEdge2->GetEnd())
-            {
-            SGM::Point3D Pos=pEdge2->GetStart()->GetPoint();
-            SGM::Point3D CPos;
-            double t=pEdge1->GetCurve()->Inverse(Pos,&CPos);
-            if(Pos.Distance(CPos)<SGM_ZERO)
-                {
-                if(pEdge1->GetDomain().InInterval(t,SGM_MIN_TOL))
-                    {
-                    return true;
-                    }
-                }
-            }
+        return false;
         }
+    SGM::Point3D const &Pos=pVertex->GetPoint();
+    SGM::Point3D CPos;
+    double t=pEdge->GetCurve()->Inverse(Pos,&CPos);
+    return Pos.Distance(CPos)<SGM_ZERO && pEdge->GetDomain().InInterval(t,SGM_MIN_TOL);
+    }
 
-    return false;
+bool EdgesOverlap(edge const *pEdge1,edge const *pEdge2)
+    {
+    // Only check the end points of each edge against the other edge.
+
+    return VertexOnEdge(pEdge1->GetStart(),pEdge2) || VertexOnEdge(pEdge1->GetEnd(),pEdge2) ||
+           VertexOnEdge(pEdge2->GetStart(),pEdge1) || VertexOnEdge(pEdge2->GetEnd(),pEdge1);
     }
 
 bool OverlappingEdges(SGM::Result              &rResult,
@@ -136,21 +246,35 @@ bool OverlappingEdges(SGM::Result              &rResult,
     std::set<edge *,EntityCompare> sEdges;
     FindEdges(rResult,pEntity,sEdges);
 
-    // Note that this is n^2 and could be n*ln(n).
+    // Only edges with intersecting boxes are compared.
 
+    SGM::BoxTree EdgeTree;
+    for(edge *pEdge : sEdges)
+        {
+        EdgeTree.Insert(pEdge,pEdge->GetBox(rResult));
+        }
     for(edge *pEdge1 : sEdges)
         {
-        for(edge *pEdge2 : sEdges)
+        std::vector<void const*> aHits=EdgeTree.FindIntersectsBox(pEdge1->GetBox(rResult));
+        std::vector<edge *> aCandidates;
+        aCandidates.reserve(aHits.size());
+        for(void const *pHit : aHits)
             {
-            if(pEdge1!=pEdge2)
+            edge *pEdge2=(edge *)pHit;
+            if(pEdge1->GetID()<pEdge2->GetID())
                 {
-                if(EdgesOverlap(pEdge1,pEdge2))
-                    {
-                    std::stringstream ss;
-                    ss << pEntity << " has overlapping edges, " << pEdge1 << " and " << pEdge2 << " .";
-                    aCheckStrings.emplace_back(ss.str());
-                    return true;
-                    }
+                aCandidates.push_back(pEdge2);
+                }
+            }
+        std::sort(aCandidates.begin(),aCandidates.end(),EntityCompare());
+        for(edge *pEdge2 : aCandidates)
+            {
+            if(EdgesOverlap(pEdge1,pEdge2))
+                {
+                std::stringstream ss;
+                ss << pEntity << " has overlapping edges, " << pEdge1 << " and " << pEdge2 << " .";
+                aCheckStrings.emplace_back(ss.str());
+                return true;
                 }
             }
         }
@@ -185,10 +309,10 @@ bool body::Check(SGM::Result              &rResult,
         aCheckStrings.emplace_back(ss.str());
         }
 
-    //if(OverlappingEdges(rResult,this,aCheckStrings))
-    //    {
-    //    bAnswer=false;
-    //    }
+    if(Options.m_bOverlappingEdges && OverlappingEdges(rResult,this,aCheckStrings))
+        {
+        bAnswer=false;
+        }
 
     if(bChildren)
         {
@@ -201,6 +325,38 @@ bool body::Check(SGM::Result              &rResult,
     return bAnswer;
     }
 
+bool reference::Check(SGM::Result              &rResult,
+                      SGM::CheckOptions  const &Options,
+                      std::vector<std::string> &aCheckStrings,
+                      bool                      bChildren) const
+    {
+    bool bAnswer=true;
+
+    if(m_pBody==nullptr)
+        {
+        bAnswer=false;
+        std::stringstream ss;
+        ss << this << " does not reference a body.";
+        aCheckStrings.emplace_back(ss.str());
+        }
+    else
+        {
+        if(m_pBody->GetOwners().find((entity *)this)==m_pBody->GetOwners().end())
+            {
+            bAnswer=false;
+            std::stringstream ss;
+            ss << m_pBody << " of " << this << " is not owned by this reference.";
+            aCheckStrings.emplace_back(ss.str());
+            }
+        if(bChildren && !m_pBody->Check(rResult,Options,aCheckStrings,true))
+            {
+            bAnswer=false;
+            }
+        }
+
+    return bAnswer;
+    }
+
 bool complex::Check(SGM::Result              &rResult,
                     SGM::CheckOptions  const &,//Options,
                     std::vector<std::string> &aCheckStrings,
@@ -620,6 +776,32 @@ bool face::Check(SGM::Result              &rResult,
         }
     nDoubleEdges/=2;
 
+    if(nTotalEdges-nDoubleEdges!=m_sEdges.size())
+        {
+        bAnswer=false;
+        std::stringstream ss;
+        ss << "The loops of " << this << " are missing " << (nDoubleEdges+m_sEdges.size())-nTotalEdges << " edges.";
+        aCheckStrings.emplace_back(ss.str());
+        }
+
+    if(Options.m_nLevel<SGM::CheckGeometryLevel)
+        {
+        return bChildren ? CheckChildren(rResult,this,Options,aCheckStrings) && bAnswer : bAnswer;
+        }
+
+    if(1E+10<GetBox(rResult).Diagonal())
+        {
+        bAnswer=false;
+        std::stringstream ss;
+        ss << this << " has an infinite bounding box.";
+        aCheckStrings.emplace_back(ss.str());
+        }
+
+    if(Options.m_nLevel<SGM::CheckFacetLevel)
+        {
+        return bChildren ? CheckChildren(rResult,this,Options,aCheckStrings) && bAnswer : bAnswer;
+        }
+
     if(m_sEdges.size()<4)
         {
         double dSliverValue=SliverValue(rResult);
@@ -632,14 +814,6 @@ bool face::Check(SGM::Result              &rResult,
             }
         }
 
-    if(nTotalEdges-nDoubleEdges!=m_sEdges.size())
-        {
-        bAnswer=false;
-        std::stringstream ss;
-        ss << "The loops of " << this << " are missing " << (nDoubleEdges+m_sEdges.size())-nTotalEdges << " edges.";
-        aCheckStrings.emplace_back(ss.str());
-        }
-
     // Check the facets
 
     size_t nTriangles=GetTriangles(rResult).size(); // Called to force facets to exist.
@@ -704,14 +878,6 @@ bool face::Check(SGM::Result              &rResult,
             }
         }
 
-    if(1E+10<GetBox(rResult).Diagonal())
-        {
-        bAnswer=false;
-        std::stringstream ss;
-        ss << this << " has an infinite bounding box.";
-        aCheckStrings.emplace_back(ss.str());
-        }
-
     if(bChildren)
         {
         if(CheckChildren(rResult,this,Options,aCheckStrings)==false)
@@ -813,7 +979,7 @@ bool edge::Check(SGM::Result              &rResult,
         aCheckStrings.emplace_back(ss.str());
         }
 
-    if(1E+10<GetBox(rResult).Diagonal())
+    if(SGM::CheckGeometryLevel<=Options.m_nLevel && 1E+10<GetBox(rResult).Diagonal())
         {
         bAnswer=false;
         std::stringstream ss;
@@ -867,7 +1033,7 @@ bool curve::Check(SGM::Result              &rResult,
                   bool                      bChildren) const
     {
     bool bAnswer = true;
-    if (m_CurveType != SGM::PointCurveType)
+    if (m_CurveType != SGM::PointCurveType && SGM::CheckGeometryLevel<=Options.m_nLevel)
     {
         bAnswer=TestCurve(rResult,this,m_Domain.MidPoint());
 
@@ -909,17 +1075,21 @@ bool surface::CheckImplementation(SGM::Result              &rResult,
                                   std::vector<std::string> &aCheckStrings,
                                   bool                      bChildren) const
     {
-    SGM::Point2D uv=m_Domain.MidPoint();
-    if(!m_sFaces.empty())
+    bool bAnswer=true;
+    if(SGM::CheckGeometryLevel<=Options.m_nLevel)
         {
-        face *pFace=*(m_sFaces.begin());
-        std::vector<SGM::Point2D> const &aPoints=pFace->GetPoints2D(rResult);
-        if(!aPoints.empty())
+        SGM::Point2D uv=m_Domain.MidPoint();
+        if(!m_sFaces.empty())
             {
-            uv=SGM::FindCenterOfMass2D(aPoints);
+            face *pFace=*(m_sFaces.begin());
+            std::vector<SGM::Point2D> const &aPoints=pFace->GetPoints2D(rResult);
+            if(!aPoints.empty())
+                {
+                uv=SGM::FindCenterOfMass2D(aPoints);
+                }
             }
+        bAnswer=TestSurface(rResult,this,uv);
         }
-    bool bAnswer=TestSurface(rResult,this,uv);
 
     // Extream surface testing.
 
@@ -4,6 +4,7 @@
 #include "Curve.h"
 #include "Surface.h"
 #include "Intersectors.h"
+#include "Util/profile.h"
 
 namespace SGMInternal {
 
@@ -120,6 +121,8 @@ void cone::Evaluate(SGM::Point2D const &uv,
                     SGM::Vector3D      *Duv,
                     SGM::Vector3D      *Dvv) const
     {
+    SGM_PROFILE_COUNT(ProfileSurfaceEvaluate);
+
     double dVScale=m_dRadius*(1.0-uv.m_v*m_dSinHalfAngle);
     double dCosU=cos(uv.m_u);
     double dSinU=sin(uv.m_u);
@@ -204,6 +207,8 @@ SGM::Point2D cone::Inverse(SGM::Point3D const &Pos,
                            SGM::Point3D       *ClosePos,
                            SGM::Point2D const *pGuess) const
     {
+    SGM_PROFILE_COUNT(ProfileSurfaceInverse);
+
     double x=Pos.m_x-m_Origin.m_x;
     double y=Pos.m_y-m_Origin.m_y;
     double z=Pos.m_z-m_Origin.m_z;
@@ -3,6 +3,7 @@
 #include "Curve.h"
 #include "Mathematics.h"
 #include "Surface.h"
+#include "Util/profile.h"
 
 namespace SGMInternal 
 {
@@ -82,6 +83,8 @@ void cylinder::Evaluate(SGM::Point2D const &uv,
                         SGM::Vector3D      *Duv,
                         SGM::Vector3D      *Dvv) const
     {
+    SGM_PROFILE_COUNT(ProfileSurfaceEvaluate);
+
     double dCos=cos(uv.m_u);
     double dSin=sin(uv.m_u);
 
@@ -134,6 +137,8 @@ SGM::Point2D cylinder::Inverse(SGM::Point3D const &Pos,
                                SGM::Point3D       *ClosePos,
                                SGM::Point2D const *pGuess) const
     {
+    SGM_PROFILE_COUNT(ProfileSurfaceInverse);
+
     double x=Pos.m_x-m_Origin.m_x;
     double y=Pos.m_y-m_Origin.m_y;
     double z=Pos.m_z-m_Origin.m_z;
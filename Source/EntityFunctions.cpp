@@ -65,6 +65,18 @@ void DeleteEntity(SGM::Result &rResult,
         return;
     }
 
+    // a body shared with other references is kept with all of its children
+    if (pEntity->GetType() == SGM::ReferenceType)
+    {
+        body *pBody = ((reference *)pEntity)->GetBody();
+        if (pBody && 1 < pBody->GetOwners().size())
+        {
+            pEntity->SeverRelations(rResult);
+            rResult.GetThing()->DeleteEntity(pEntity);
+            return;
+        }
+    }
+
     std::set<entity *, EntityCompare> sEntitiesToDelete;
     std::set<entity *, EntityCompare> sEntitiesToKeep;
     FindChildrenToDeleteAndToKeep(pEntity, sEntitiesToDelete, sEntitiesToKeep);
@@ -167,6 +179,15 @@ struct TransformVisitor: EntityVisitor
     //inline void Visit(assembly &)  override { /* TODO: handle assembly transform */ }
     //inline void Visit(attribute &) override { /* do nothing */ }
     inline void Visit(body &b)     override { b.TransformBox(*pResult, m_Transform3D); }
+
+    // The referenced body is moved as well, so the placement is conjugated.
+    inline void Visit(reference &r) override
+        {
+        SGM::Transform3D Inverse;
+        m_Transform3D.Inverse(Inverse);
+        r.SetTransform(*pResult, Inverse*r.GetTransform()*m_Transform3D);
+        }
+
     inline void Visit(complex &c)  override { c.TransformBox(*pResult, m_Transform3D); c.Transform(m_Transform3D); }
 
     inline void Visit(edge &e)   override { e.TransformBox(*pResult, m_Transform3D); e.TransformFacets(m_Transform3D); }
@@ -218,6 +239,13 @@ void TransformEntity(SGM::Result            &rResult,
 			return;
         }
 
+
+        if (pEntity->GetType() == SGM::ReferenceType)
+        {
+            // only the placement moves, the body is shared with other references
+            ((reference *)pEntity)->Transform(rResult, transform3D);
+            return;
+        }
         
         std::set<entity *,EntityCompare> sFamily;
         pEntity->FindAllChildren(sFamily);
@@ -8,6 +8,7 @@
 #include "EntityFunctions.h"
 #include "Surface.h"
 #include "Curve.h"
+#include "Util/profile.h"
 
 namespace SGMInternal
 {
@@ -100,6 +101,8 @@ void extrude::Evaluate(SGM::Point2D const &uv,
                        SGM::Vector3D      *Duv,
                        SGM::Vector3D      *Dvv) const
     {
+    SGM_PROFILE_COUNT(ProfileSurfaceEvaluate);
+
     SGM::Point3D   CurvePos;
     SGM::Vector3D  DuCurve;
     SGM::Vector3D *pDuCurve = &DuCurve;
@@ -154,6 +157,8 @@ SGM::Point2D extrude::Inverse(SGM::Point3D const &Pos,
                               SGM::Point3D       *ClosePos,
                               SGM::Point2D const *pGuess) const
     {
+    SGM_PROFILE_COUNT(ProfileSurfaceInverse);
+
     SGM::Point2D uv;
 
     uv.m_v=(Pos-m_Origin)%m_vAxis;
@@ -18,6 +18,7 @@
 
 #include <cfloat>
 #include <algorithm>
+#include "Util/profile.h"
 
 ///////////////////////////////////////////////////////////////////////////////
 //
@@ -750,6 +751,8 @@ bool face::PointInFace(SGM::Result        &rResult,
                        edge               **pInCloseEdge,
                        bool               *bOnEdge) const
     {
+    SGM_PROFILE_COUNT(ProfilePointInFace);
+
     // First check to see if the point is in the UV bounding box.
 
     if(m_UVBox.IsEmpty()==false && m_UVBox.InInterval(uv,SGM_ZERO)==false)
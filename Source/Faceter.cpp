@@ -22,6 +22,7 @@
 #include <list>
 #include <cmath>
 #include <algorithm>
+#include "Util/profile.h"
 
 namespace SGMInternal
 {
@@ -3336,6 +3337,8 @@ void FacetFace(SGM::Result                    &rResult,
                std::vector<SGM::UnitVector3D> &aNormals,
                std::vector<unsigned int>      &aTriangles)
     {
+    SGM_PROFILE_COUNT(ProfileFacetFace);
+
     // Code added for code coverage.
 
     if(rResult.GetDebugFlag())
@@ -12,6 +12,7 @@
 #include "SGMBoxTree.h"
 #include "SGMTranslators.h"
 #include "SGMEnums.h"
+#include "SGMTransform.h"
 
 #include "OrderPoints.h"
 #include "Signature.h"
@@ -264,6 +265,8 @@ class thing : public entity
 
         std::unordered_set<body *> GetBodies(bool bTopLevel=false) const;
 
+        std::unordered_set<reference *> GetReferences(bool bTopLevel=false) const;
+
         std::unordered_set<volume *> GetVolumes(bool bTopLevel=false) const;
 
         std::unordered_set<face *> GetFaces(bool bTopLevel=false) const;
@@ -411,6 +414,14 @@ class reference : public topology
 
         explicit reference(SGM::Result &rResult);
 
+        // An instance of pBody placed by Transform.  The reference becomes an
+        // owner of pBody, so that pBody is no longer top level and only its
+        // instances are seen from the thing.
+
+        reference(SGM::Result            &rResult,
+                  body                   *pBody,
+                  SGM::Transform3D const &Transform);
+
         reference(SGM::Result &rResult, reference const &other);
 
         reference() = delete;
@@ -425,6 +436,8 @@ class reference : public topology
 
         reference *Clone(SGM::Result &rResult) const override;
 
+        void FindAllChildren(std::set<entity *, EntityCompare> &sChildren) const override;
+
         SGM::Interval3D const &GetBox(SGM::Result &,bool bContruct=true) const override;
 
         bool IsTopLevel() const override;
@@ -432,9 +445,13 @@ class reference : public topology
         void RemoveParentsInSet(SGM::Result &,
                                 std::set<entity *,EntityCompare>  const &) override {}
 
-        void DisconnectOwnedEntity(entity const *) override {}
+        void DisconnectOwnedEntity(entity const *pEntity) override;
 
-        void ReplacePointers(std::map<entity *, entity *> const &) override;
+        void ReplacePointers(std::map<entity *, entity *> const &mEntityMap) override;
+
+        void SeverRelations(SGM::Result &rResult) override;
+
+        void TransformBox(SGM::Result &rResult, SGM::Transform3D const &transform3D) override;
 
         void WriteSGM(SGM::Result                  &rResult,
                       FILE                         *pFile,
@@ -445,7 +462,26 @@ class reference : public topology
                    std::vector<std::string> &aCheckStrings,
                    bool                      bChildern) const override;
 
+        void SetBody(body *pBody);
+
+        void SetTransform(SGM::Result &rResult, SGM::Transform3D const &Transform);
+
+        // Moves the instance, Transform is applied after the current transform.
+
+        void Transform(SGM::Result &rResult, SGM::Transform3D const &Transform);
+
+        // Get methods
+
+        body *GetBody() const {return m_pBody;}
+
+        SGM::Transform3D const &GetTransform() const {return m_Transform;}
+
         void Swap(reference &other);
+
+    private:
+
+        body             *m_pBody;
+        SGM::Transform3D  m_Transform;
     };
 
 class body : public topology
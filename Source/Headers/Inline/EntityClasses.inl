@@ -336,12 +336,23 @@ namespace SGMInternal {
     //
 
     inline reference::reference(SGM::Result &rResult) : 
-            topology(rResult, SGM::EntityType::BodyType)
+            topology(rResult, SGM::EntityType::ReferenceType),
+            m_pBody(nullptr)
     {}
 
+    inline reference::reference(SGM::Result            &rResult,
+                                body                   *pBody,
+                                SGM::Transform3D const &Transform) :
+            topology(rResult, SGM::EntityType::ReferenceType),
+            m_pBody(nullptr),
+            m_Transform(Transform)
+    { SetBody(pBody); }
+
     inline reference::reference(SGM::Result &rResult, reference const &other) : 
-            topology(rResult, other) 
-    {}
+            topology(rResult, other),
+            m_pBody(nullptr),
+            m_Transform(other.m_Transform)
+    { SetBody(other.m_pBody); }
 
     inline void reference::Accept(EntityVisitor &v)
     { v.Visit(*this); }
@@ -349,23 +360,21 @@ namespace SGMInternal {
     inline reference *reference::Clone(SGM::Result &rResult) const
     { return new reference(rResult,*this); }
 
-    inline SGM::Interval3D const &reference::GetBox(SGM::Result &,bool /*bDoNotContruct*/) const
-    { return m_Box; }
-
     inline bool reference::IsTopLevel() const
     { return m_sOwners.empty(); }
 
-    inline void reference::ReplacePointers(std::map<entity *, entity *> const &)
-    { throw std::logic_error("not implemented yet for reference"); }
+    inline void reference::DisconnectOwnedEntity(entity const *pEntity)
+    { if (pEntity == m_pBody) m_pBody = nullptr; }
+
+    inline void reference::TransformBox(SGM::Result &, SGM::Transform3D const &)
+    { m_Box.Reset(); }
 
-    inline bool reference::Check(SGM::Result &,
-                                 SGM::CheckOptions const  &,
-                                 std::vector<std::string> &,
-                                 bool) const 
-    {return true;}
-    
     inline void reference::Swap(reference &other)
-    { topology::Swap(other); }
+    { 
+        topology::Swap(other); 
+        std::swap(m_pBody, other.m_pBody);
+        std::swap(m_Transform, other.m_Transform);
+    }
 
     //
     // body
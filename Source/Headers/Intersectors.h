@@ -36,6 +36,19 @@ size_t RayFireBody(SGM::Result                        &rResult,
                    double                              dTolerance,
                    bool                                bUseWholeLine=false);
 
+// Fires the ray at the body of pReference placed by its transform.  The
+// returned entities are those of the shared body.
+
+size_t RayFireReference(SGM::Result                        &rResult,
+                        SGM::Point3D                 const &Origin,
+                        SGM::UnitVector3D            const &Axis,
+                        reference                    const *pReference,
+                        std::vector<SGM::Point3D>          &aPoints,
+                        std::vector<SGM::IntersectionType> &aTypes,
+                        std::vector<entity *>              &aEntites,
+                        double                              dTolerance,
+                        bool                                bUseWholeLine=false);
+
 // Supply the candidate faces, or an empty list of faces
 
 size_t RayFireVolume(SGM::Result                                      &rResult,
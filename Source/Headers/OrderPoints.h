@@ -5,6 +5,7 @@
 #include "Util/buffer.h"
 
 #include <cfloat>
+#include <cstdint>
 #include <cmath>
 #include <iostream>
 
@@ -19,12 +20,12 @@ namespace SGMInternal
 
 /// Return an index of the lexicographical (dictionary) order of the point cloud.
 //
-// This maps the points in the array to one dimension while preserving
-// spatial locality of the points.
+// The coordinates are mapped to order preserving 64-bit integers and the
+// index is sorted with a stable LSD radix sort, so points that are equal
+// keep their original relative order.
 //
 // Input:
 //      - vector of Point3D
-//      - vector of Point3DSeparate corresponding to each Point3D
 //
 buffer<unsigned> OrderPointsLexicographical(std::vector<SGM::Point3D> const &aPoints);
 
@@ -32,15 +33,47 @@ buffer<unsigned> OrderPointsLexicographical(std::vector<SGM::Point3D> const &aPo
 /// Return an index of the Z-order (Morton order) of the point cloud.
 //
 // This maps the points in the array to one dimension while preserving
-// spatial locality of the points.
+// spatial locality of the points.  The points are quantized into 21 bits
+// per axis of their bounding box to make 63-bit integer keys that are
+// sorted with a stable LSD radix sort.  Points that share a key are then
+// ordered by the exact floating point Z-order (LessZOrder).
 //
 // Input:
 //      - vector of Point3D
-//      - vector of Point3DSeparate corresponding to each Point3D
 //
 buffer<unsigned> OrderPointsMorton(std::vector<SGM::Point3D> const &aPoints);
 
 
+/// Return an index of the Hilbert curve order of the point cloud.
+//
+// Same as OrderPointsMorton, but the 63-bit keys are distances along a
+// three dimensional Hilbert curve, which has better locality than the
+// Z-order since consecutive cells of the curve are always adjacent.
+//
+// Input:
+//      - vector of Point3D
+//
+buffer<unsigned> OrderPointsHilbert(std::vector<SGM::Point3D> const &aPoints);
+
+
+/// Return the 63-bit Morton key of grid coordinates with 21 bits each,
+// where the z bit is the most significant bit of each level.
+uint64_t MortonKey(unsigned nX, unsigned nY, unsigned nZ);
+
+
+/// Return the 63-bit Hilbert key of grid coordinates with 21 bits each.
+uint64_t HilbertKey(unsigned nX, unsigned nY, unsigned nZ);
+
+
+/// Sort the index aIndices by the 64-bit keys aKeys, where aKeys[i] is
+// the key of aIndices[i].  The sort is a stable LSD radix sort over the
+// bytes of the keys that are not the same for all keys, and both vectors
+// are reordered.  When SGM_MULTITHREADED is defined, the histograms and
+// the scatter of each pass are done in parallel over chunks of the keys.
+void RadixSortKeys(buffer<uint64_t> &aKeys,
+                   buffer<unsigned> &aIndices);
+
+
 /// True if points are close using only a relative tolerance.
 inline bool AlmostEqual(SGM::Point3D const &p, SGM::Point3D const &q, double dRelativeToleranceSquared)
     {
@@ -186,10 +186,11 @@ size_t ParseSTEPStreamConcurrent(SGM::Result                  &rResult,
                                  STEPLineDataMapType          &mSTEPData);
 #endif
 
-void CreateEntities(SGM::Result           &rResult,
-                    size_t                 maxSTEPLineNumber,
-                    STEPLineDataMapType   &mSTEPData,
-                    std::vector<entity *> &aEntities);
+void CreateEntities(SGM::Result                  &rResult,
+                    SGM::TranslatorOptions const &Options,
+                    size_t                        maxSTEPLineNumber,
+                    STEPLineDataMapType          &mSTEPData,
+                    std::vector<entity *>        &aEntities);
 
 void ProcessSTEPLine(STEPTagMapType const &mSTEPTagMap,
                      std::string &sLine,
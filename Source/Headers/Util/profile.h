@@ -0,0 +1,108 @@
+#ifndef SGM_PROFILE_H
+#define SGM_PROFILE_H
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Library wide instrumentation.
+//
+// Profiling is turned on and off at run time with SGM::Result::SetProfiling.
+// When it is off, a zone or a counter costs one relaxed atomic load.
+// Define SGM_NO_PROFILE to compile all of the instrumentation away.
+//
+//  void FindSomething()
+//      {
+//      SGM_PROFILE_ZONE("FindSomething");   // timed until the end of the scope
+//      SGM_PROFILE_COUNT(ProfileFacetFace); // counted each call
+//      ...
+//      }
+//
+// Zones nest, and each thread records its zones and counts into its own
+// buffer, so no locking is done while profiled code is running.  The
+// buffers are written out as Chrome trace JSON or as a summary table by
+// the functions in SGMProfile.h.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <atomic>
+#include <cstddef>
+
+namespace SGMInternal
+{
+
+// Counters for the hot kernels of the library.  ProfileCounterNames in
+// Profile.cpp must match this order.
+
+enum ProfileCounter
+    {
+    ProfileSurfaceEvaluate,
+    ProfileSurfaceInverse,
+    ProfilePointInFace,
+    ProfileIntersectLineAndSurface,
+    ProfileFacetFace,
+    ProfileCounterCount
+    };
+
+extern std::atomic<bool> g_bProfiling;
+
+inline bool IsProfiling()
+    {
+    return g_bProfiling.load(std::memory_order_relaxed);
+    }
+
+void ProfileBegin(char const *sName);
+
+void ProfileEnd();
+
+void ProfileCount(ProfileCounter nCounter);
+
+class ProfileZone
+    {
+    public:
+
+        explicit ProfileZone(char const *sName) : m_bActive(IsProfiling())
+            {
+            if (m_bActive)
+                {
+                ProfileBegin(sName);
+                }
+            }
+
+        ~ProfileZone()
+            {
+            if (m_bActive)
+                {
+                ProfileEnd();
+                }
+            }
+
+        ProfileZone(ProfileZone const &) = delete;
+
+        ProfileZone &operator=(ProfileZone const &) = delete;
+
+    private:
+
+        bool m_bActive;
+    };
+
+} // namespace SGMInternal
+
+#define SGM_PROFILE_CONCAT_IMPL(a,b) a##b
+#define SGM_PROFILE_CONCAT(a,b) SGM_PROFILE_CONCAT_IMPL(a,b)
+
+#ifndef SGM_NO_PROFILE
+
+#define SGM_PROFILE_ZONE(sName)                                          \
+    SGMInternal::ProfileZone SGM_PROFILE_CONCAT(sgmProfileZone,__LINE__)(sName)
+
+#define SGM_PROFILE_COUNT(nCounter)                                      \
+    do { if (SGMInternal::IsProfiling())                                 \
+             SGMInternal::ProfileCount(SGMInternal::nCounter); } while (false)
+
+#else
+
+#define SGM_PROFILE_ZONE(sName)
+#define SGM_PROFILE_COUNT(nCounter) do {} while (false)
+
+#endif // SGM_NO_PROFILE
+
+#endif // SGM_PROFILE_H
@@ -1200,6 +1200,17 @@ bool PointInEntity(SGM::Result        &rResult,
             bAnswer=PointInBody(rResult,Point,(body const *)pEntity,dTolerance);
             break;
             }
+        case SGM::ReferenceType:
+            {
+            auto pReference=(reference const *)pEntity;
+            if(body const *pBody=pReference->GetBody())
+                {
+                SGM::Transform3D Inverse;
+                pReference->GetTransform().Inverse(Inverse);
+                bAnswer=PointInBody(rResult,Inverse*Point,pBody,dTolerance);
+                }
+            break;
+            }
         case SGM::VolumeType:
             {
             bAnswer=PointInVolume(rResult,Point,(volume const *)pEntity,dTolerance);
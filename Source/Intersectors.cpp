@@ -18,8 +18,7 @@
 #include "EntityFunctions.h"
 #include "Curve.h"
 
-//#define SGM_TIMER
-#include "Util/timer.h"
+#include "Util/profile.h"
 
 // Lets us use fprintf
 #ifdef _MSC_VER
@@ -924,8 +923,7 @@ size_t RayFireVolume(SGM::Result                                      &rResult,
     aTypes.clear();
     aEntities.clear();
 
-    SGM_TIMER_INITIALIZE();
-    SGM_TIMER_START("RayFireVolume");
+    SGM_PROFILE_ZONE("RayFireVolume");
 
     if (aHitFacesSupplied.empty())
         {
@@ -964,8 +962,6 @@ size_t RayFireVolume(SGM::Result                                      &rResult,
 
     size_t nAnswer=OrderAndRemoveDuplicates(Origin,Axis,SGM_FIT,bUseWholeLine,aPoints,aTypes,aEntities);
 
-    SGM_TIMER_STOP();
-
     return nAnswer;
     }
 
@@ -1003,6 +999,39 @@ size_t RayFireBody(SGM::Result                        &rResult,
     return nAnswer;
     }
 
+size_t RayFireReference(SGM::Result                        &rResult,
+                        SGM::Point3D                 const &Origin,
+                        SGM::UnitVector3D            const &Axis,
+                        reference                    const *pReference,
+                        std::vector<SGM::Point3D>          &aPoints,
+                        std::vector<SGM::IntersectionType> &aTypes,
+                        std::vector<entity *>              &aEntitiy,
+                        double                              dTolerance,
+                        bool                                bUseWholeLine)
+    {
+    body const *pBody=pReference->GetBody();
+    if(pBody==nullptr)
+        {
+        aPoints.clear();
+        aTypes.clear();
+        return 0;
+        }
+
+    // Fire the ray in the coordinates of the body and move the hits back.
+
+    SGM::Transform3D const &Trans=pReference->GetTransform();
+    SGM::Transform3D Inverse;
+    Trans.Inverse(Inverse);
+    SGM::Point3D LocalOrigin=Inverse*Origin;
+    SGM::UnitVector3D LocalAxis=Inverse*Axis;
+    size_t nAnswer=RayFireBody(rResult,LocalOrigin,LocalAxis,pBody,aPoints,aTypes,aEntitiy,dTolerance,bUseWholeLine);
+    for(auto &Pos : aPoints)
+        {
+        Pos=Trans*Pos;
+        }
+    return nAnswer;
+    }
+
 inline void MovePointsAndTypes(std::vector<SGM::Point3D>          &aSubPoints,
                                std::vector<SGM::IntersectionType> &aSubTypes,
                                std::vector<entity *>              &aSubEntities,
@@ -1050,6 +1079,12 @@ size_t RayFireThing(SGM::Result                        &rResult,
         MovePointsAndTypes(aSubPoints, aSubTypes, aSubEntities, aPoints, aTypes, aEntities);
         }
 
+    for (auto pReference : pThing->GetReferences(true))
+        {
+        RayFireReference(rResult,Origin,Axis,pReference,aSubPoints,aSubTypes,aSubEntities,dTolerance,bUseWholeLine);
+        MovePointsAndTypes(aSubPoints, aSubTypes, aSubEntities, aPoints, aTypes, aEntities);
+        }
+
     std::set<volume *,EntityCompare> sVolumes;
     FindVolumes(rResult,pThing,sVolumes,true);
     std::vector<face *> aTreeHitFaces;
@@ -1126,6 +1161,10 @@ size_t RayFire(SGM::Result                        &rResult,
             {
             return RayFireBody(rResult,Origin,Axis,(body const *)pEntity,aPoints,aTypes,aEntities,dTolerance,bUseWholeLine);
             }
+        case SGM::ReferenceType:
+            {
+            return RayFireReference(rResult,Origin,Axis,(reference const *)pEntity,aPoints,aTypes,aEntities,dTolerance,bUseWholeLine);
+            }
         case SGM::VolumeType:
             {
             std::vector<face*> aTreeHitFaces;
@@ -2731,6 +2770,8 @@ size_t IntersectLineAndSurface(SGM::Result                        &rResult,
                                std::vector<SGM::Point3D>          &aPoints,
                                std::vector<SGM::IntersectionType> &aTypes)
     {
+    SGM_PROFILE_COUNT(ProfileIntersectLineAndSurface);
+
 #ifdef SGM_TIMING_RAY_FIRE
     rResult.IncrementIntersectLineAndEntityCount(pSurface->GetSurfaceType());
 #endif
@@ -2786,6 +2827,8 @@ size_t IntersectLineAndSurface(SGM::Result                        &rResult,
                                std::vector<SGM::Point3D>          &aPoints,
                                std::vector<SGM::IntersectionType> &aTypes)
     {
+    SGM_PROFILE_COUNT(ProfileIntersectLineAndSurface);
+
     std::vector<SGM::Point3D> aTempPoints;
     std::vector<SGM::IntersectionType> aTempTypes;
     IntersectLineAndSurface(rResult,pLine->m_Origin,pLine->m_Axis,pLine->GetDomain(),
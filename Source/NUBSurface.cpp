@@ -5,6 +5,7 @@
 #include "Surface.h"
 #include "Curve.h"
 #include "Faceter.h"
+#include "Util/profile.h"
 
 namespace SGMInternal
 {
@@ -298,6 +299,8 @@ void NUBsurface::Evaluate(SGM::Point2D const &uv,
                           SGM::Vector3D      *Duv,
                           SGM::Vector3D      *Dvv) const
     {
+    SGM_PROFILE_COUNT(ProfileSurfaceEvaluate);
+
     // From "The NURBs Book" Algorithm A3.6.
 
     size_t nUDegree=GetUDegree();
@@ -437,6 +440,8 @@ SGM::Point2D NUBsurface::Inverse(SGM::Point3D const &Pos,
                                  SGM::Point3D       *ClosePos,
                                  SGM::Point2D const *pGuess) const
     {
+    SGM_PROFILE_COUNT(ProfileSurfaceInverse);
+
     SGM::Point2D uv;
 
     SGM::Point2D StartUV(0.0,0.0);
@@ -7,6 +7,7 @@
 #include "Faceter.h"
 
 #include "Primitive.h"
+#include "Util/profile.h"
 
 namespace SGMInternal
 {
@@ -133,6 +134,8 @@ void NURBsurface::Evaluate(SGM::Point2D const &uv,
                            SGM::Vector3D      * Duv,
                            SGM::Vector3D      * Dvv) const
     {
+    SGM_PROFILE_COUNT(ProfileSurfaceEvaluate);
+
     // From "The NURBs Book" Algorithm A3.6.
 
     double aUMemory[SGM_MAX_NURB_DERIVATIVE_PLUS_ONE*SGM_MAX_NURB_DEGREE_PLUS_ONE];
@@ -495,6 +498,8 @@ SGM::Point2D NURBsurface::Inverse(SGM::Point3D const &Pos,
                                   SGM::Point3D       *ClosePos,
                                   SGM::Point2D const *pGuess) const
     {
+    SGM_PROFILE_COUNT(ProfileSurfaceInverse);
+
     SGM::Point2D uv;
 
     SGM::Point2D StartUV(0.0,0.0);
@@ -8,6 +8,7 @@
 #include "Surface.h"
 #include "Primitive.h"
 #include "Faceter.h"
+#include "Util/profile.h"
 
 namespace SGMInternal
 {
@@ -95,6 +96,8 @@ void offset::Evaluate(SGM::Point2D const &uv,
                       SGM::Vector3D      *Duv,
                       SGM::Vector3D      *Dvv) const
     {
+    SGM_PROFILE_COUNT(ProfileSurfaceEvaluate);
+
     SGM::Point3D BPos;
     SGM::UnitVector3D BNorm;
     SGM::Vector3D du,dv,duu,duv,dvv;
@@ -165,6 +168,8 @@ SGM::Point2D offset::Inverse(SGM::Point3D const &Pos,
                              SGM::Point3D       *ClosePos,
                              SGM::Point2D const *pGuess) const
     {
+    SGM_PROFILE_COUNT(ProfileSurfaceInverse);
+
     SGM::Point2D StartUV=m_pSurface->Inverse(Pos,nullptr,pGuess);
     StartUV=NewtonsMethod(StartUV,Pos);
     if(ClosePos)
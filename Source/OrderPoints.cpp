@@ -1,41 +1,218 @@
 #include "OrderPoints.h"
 
-#if defined(SGM_MULTITHREADED) && !defined(_MSC_VER)
-#include "Util/parallel_sort.h"
+#include <numeric>
+
+#if defined(SGM_MULTITHREADED)
+#include <thread>
+#include "SGMThreadPool.h"
 #endif
 
 namespace SGMInternal
 {
 
+///////////////////////////////////////////////////////////////////////////////
+//
+// Radix sorting of 64-bit keys
+//
+///////////////////////////////////////////////////////////////////////////////
+
+// Counts the bytes at nShift of the keys in [iBegin,iEnd).
+
+void CountKeyBytes(uint64_t const *pKeys,
+                   size_t          iBegin,
+                   size_t          iEnd,
+                   unsigned        nShift,
+                   size_t         *pCounts)
+    {
+    std::fill(pCounts,pCounts+256,0);
+    for (size_t i = iBegin; i < iEnd; ++i)
+        {
+        ++pCounts[(pKeys[i] >> nShift) & 0xFF];
+        }
+    }
+
+// Moves the keys and indices in [iBegin,iEnd) to the positions given by
+// the running offsets in pOffsets.
+
+void ScatterKeyBytes(uint64_t const *pKeys,
+                     unsigned const *pIndices,
+                     size_t          iBegin,
+                     size_t          iEnd,
+                     unsigned        nShift,
+                     size_t         *pOffsets,
+                     uint64_t       *pNewKeys,
+                     unsigned       *pNewIndices)
+    {
+    for (size_t i = iBegin; i < iEnd; ++i)
+        {
+        size_t nWhere = pOffsets[(pKeys[i] >> nShift) & 0xFF]++;
+        pNewKeys[nWhere] = pKeys[i];
+        pNewIndices[nWhere] = pIndices[i];
+        }
+    }
+
+void RadixSortKeys(buffer<uint64_t> &aKeys,
+                   buffer<unsigned> &aIndices)
+    {
+    size_t nKeys = aKeys.size();
+    assert(aIndices.size() == nKeys);
+    if (nKeys < 2)
+        {
+        return;
+        }
+
+    // Only the bytes that differ between the keys need a pass.
+
+    uint64_t nAnd = aKeys[0];
+    uint64_t nOr = aKeys[0];
+    for (size_t i = 1; i < nKeys; ++i)
+        {
+        nAnd &= aKeys[i];
+        nOr |= aKeys[i];
+        }
+    uint64_t nDiffer = nAnd ^ nOr;
+
+#if defined(SGM_MULTITHREADED)
+    const size_t MIN_CHUNK_SIZE = 1 << 16;
+    size_t nChunks = std::max((size_t)1, std::min((size_t)std::thread::hardware_concurrency(), nKeys / MIN_CHUNK_SIZE));
+#else
+    size_t nChunks = 1;
+#endif
+    std::vector<size_t> aChunkBegin(nChunks+1);
+    for (size_t iChunk = 0; iChunk <= nChunks; ++iChunk)
+        {
+        aChunkBegin[iChunk] = nKeys * iChunk / nChunks;
+        }
+    std::vector<size_t> aCounts(256*nChunks);
+
+    buffer<uint64_t> aNewKeys(nKeys);
+    buffer<unsigned> aNewIndices(nKeys);
+
+#if defined(SGM_MULTITHREADED)
+    std::unique_ptr<SGM::ThreadPool> pThreadPool;
+    if (nChunks > 1)
+        {
+        pThreadPool.reset(new SGM::ThreadPool(nChunks));
+        }
+    std::vector<std::future<void>> futures;
+#endif
+
+    for (unsigned nShift = 0; nShift < 64; nShift += 8)
+        {
+        if (((nDiffer >> nShift) & 0xFF) == 0)
+            {
+            continue;
+            }
+        uint64_t const *pKeys = aKeys.data();
+        unsigned const *pIndices = aIndices.data();
+
+        // Histogram of each chunk.
+
+#if defined(SGM_MULTITHREADED)
+        if (nChunks > 1)
+            {
+            for (size_t iChunk = 0; iChunk < nChunks; ++iChunk)
+                {
+                futures.emplace_back(pThreadPool->enqueue(CountKeyBytes, pKeys,
+                                                          aChunkBegin[iChunk], aChunkBegin[iChunk+1],
+                                                          nShift, &aCounts[256*iChunk]));
+                }
+            for (auto &&future: futures)
+                {
+                future.get();
+                }
+            futures.clear();
+            }
+        else
+#endif
+            {
+            CountKeyBytes(pKeys, 0, nKeys, nShift, aCounts.data());
+            }
+
+        // Exclusive prefix sum in (byte,chunk) order makes the offsets of
+        // each chunk follow the offsets of the previous chunks, which keeps
+        // the sort stable.
+
+        size_t nSum = 0;
+        for (size_t nByte = 0; nByte < 256; ++nByte)
+            {
+            for (size_t iChunk = 0; iChunk < nChunks; ++iChunk)
+                {
+                size_t nCount = aCounts[256*iChunk+nByte];
+                aCounts[256*iChunk+nByte] = nSum;
+                nSum += nCount;
+                }
+            }
+
+        // Scatter each chunk.
+
+#if defined(SGM_MULTITHREADED)
+        if (nChunks > 1)
+            {
+            for (size_t iChunk = 0; iChunk < nChunks; ++iChunk)
+                {
+                futures.emplace_back(pThreadPool->enqueue(ScatterKeyBytes, pKeys, pIndices,
+                                                          aChunkBegin[iChunk], aChunkBegin[iChunk+1],
+                                                          nShift, &aCounts[256*iChunk],
+                                                          aNewKeys.data(), aNewIndices.data()));
+                }
+            for (auto &&future: futures)
+                {
+                future.get();
+                }
+            futures.clear();
+            }
+        else
+#endif
+            {
+            ScatterKeyBytes(pKeys, pIndices, 0, nKeys, nShift, aCounts.data(),
+                            aNewKeys.data(), aNewIndices.data());
+            }
+        aKeys.swap(aNewKeys);
+        aIndices.swap(aNewIndices);
+        }
+    }
+
 ///////////////////////////////////////////////////////////////////////////////
 //
 // Ordering points by lexicographical order (dictionary order)
 //
-// Use Point3D::operator<()
+// Same order as Point3D::operator<()
 //
 ///////////////////////////////////////////////////////////////////////////////
 
+// Map a double to an unsigned integer with the same order, where -0.0 and
+// 0.0 are mapped to the same integer.
+
+inline uint64_t OrderedBits(double x)
+    {
+    if (x == 0.0)
+        {
+        x = 0.0;
+        }
+    uint64_t i;
+    std::memcpy(&i, &x, sizeof(double));
+    return (i >> 63) ? ~i : (i | (uint64_t(1) << 63));
+    }
+
 buffer<unsigned> OrderPointsLexicographical(std::vector<SGM::Point3D> const &aPoints)
     {
     // fill buffer with range [0,nPoints-1]
-    buffer<unsigned> aIndexOrdered(aPoints.size());
+    size_t nPoints = aPoints.size();
+    buffer<unsigned> aIndexOrdered(nPoints);
     std::iota(aIndexOrdered.begin(), aIndexOrdered.end(), 0);
 
-    SGM::Point3D const *pPoints = aPoints.data();
+    // A stable sort on z, then y, then x gives the order of x, then y, then z.
 
-#if defined(SGM_MULTITHREADED) && !defined(_MSC_VER)
-    parallel_sort(aIndexOrdered.begin(),
-                              aIndexOrdered.end(),
-                              [&pPoints](unsigned i, unsigned j) {
-                                  return (pPoints[i] < pPoints[j]);
-                              });
-#else
-    std::sort(aIndexOrdered.begin(),
-              aIndexOrdered.end(),
-              [&pPoints](unsigned i, unsigned j) {
-                  return (pPoints[i] < pPoints[j]);
-                  });
-#endif
+    buffer<uint64_t> aKeys(nPoints);
+    for (unsigned nAxis = 3; nAxis-- > 0;)
+        {
+        for (size_t i = 0; i < nPoints; ++i)
+            {
+            aKeys[i] = OrderedBits(aPoints[aIndexOrdered[i]][nAxis]);
+            }
+        RadixSortKeys(aKeys, aIndexOrdered);
+        }
     return aIndexOrdered;
     }
 
@@ -94,55 +271,181 @@ bool LessZOrder(const SGM::Point3D &p, const Point3DSeparate &p_s,
     return p[index_max] < q[index_max];
     }
 
-void CreatePoint3DSeparates(SGM::Point3D const *pPoints,
-                            size_t             iBegin,
-                            size_t             iEnd,
-                            Point3DSeparate    *pPointSeparates,
-                            unsigned           *pIndexOrdered)
+///////////////////////////////////////////////////////////////////////////////
+//
+// Integer keys of Z-order and Hilbert order on a 21 bit grid
+//
+///////////////////////////////////////////////////////////////////////////////
+
+static const unsigned KEY_BITS_PER_AXIS = 21;
+
+// Spread the low 21 bits of n so that there are two zero bits between each bit.
+
+inline uint64_t SpreadBitsBy2(unsigned n)
     {
-    for (size_t i = iBegin; i < iEnd; ++i)
+    uint64_t x = n & 0x1FFFFF;
+    x = (x | (x << 32)) & 0x1F00000000FFFFULL;
+    x = (x | (x << 16)) & 0x1F0000FF0000FFULL;
+    x = (x | (x << 8))  & 0x100F00F00F00F00FULL;
+    x = (x | (x << 4))  & 0x10C30C30C30C30C3ULL;
+    x = (x | (x << 2))  & 0x1249249249249249ULL;
+    return x;
+    }
+
+uint64_t MortonKey(unsigned nX, unsigned nY, unsigned nZ)
+    {
+    return SpreadBitsBy2(nX) | (SpreadBitsBy2(nY) << 1) | (SpreadBitsBy2(nZ) << 2);
+    }
+
+// Hilbert key from the transpose form of John Skilling, "Programming the
+// Hilbert curve", AIP Conference Proceedings 707, 2004.
+
+uint64_t HilbertKey(unsigned nX, unsigned nY, unsigned nZ)
+    {
+    unsigned X[3] = {nX & 0x1FFFFF, nY & 0x1FFFFF, nZ & 0x1FFFFF};
+    const unsigned M = 1u << (KEY_BITS_PER_AXIS-1);
+
+    // Inverse undo excess work.
+
+    for (unsigned Q = M; Q > 1; Q >>= 1)
         {
-        new (pPointSeparates+i) Point3DSeparate(pPoints[i]); // placement new at the address, no need to delete
+        unsigned P = Q - 1;
+        for (unsigned i = 0; i < 3; ++i)
+            {
+            if (X[i] & Q)
+                {
+                X[0] ^= P;
+                }
+            else
+                {
+                unsigned t = (X[0] ^ X[i]) & P;
+                X[0] ^= t;
+                X[i] ^= t;
+                }
+            }
         }
-    for (size_t i = iBegin; i < iEnd; ++i)
+
+    // Gray encode.
+
+    X[1] ^= X[0];
+    X[2] ^= X[1];
+    unsigned t = 0;
+    for (unsigned Q = M; Q > 1; Q >>= 1)
+        {
+        if (X[2] & Q)
+            {
+            t ^= Q - 1;
+            }
+        }
+    for (unsigned i = 0; i < 3; ++i)
         {
-        pIndexOrdered[i] = i;
+        X[i] ^= t;
         }
+
+    // The first axis of the transpose is the most significant.
+
+    return MortonKey(X[2], X[1], X[0]);
     }
 
-buffer<unsigned> OrderPointsMorton(std::vector<SGM::Point3D> const &aPoints)
+// Quantize the points into the cube of the largest side of their bounding
+// box and return the keys made by the function KeyFunction.
+
+template <class KEY_FUNCTION>
+void FindQuantizedKeys(std::vector<SGM::Point3D> const &aPoints,
+                       KEY_FUNCTION                     KeyFunction,
+                       buffer<uint64_t>                &aKeys)
     {
-    buffer<unsigned> aIndexOrdered(aPoints.size());
+    size_t nPoints = aPoints.size();
+    SGM::Point3D Min(std::numeric_limits<double>::max(),
+                     std::numeric_limits<double>::max(),
+                     std::numeric_limits<double>::max());
+    SGM::Point3D Max(-std::numeric_limits<double>::max(),
+                     -std::numeric_limits<double>::max(),
+                     -std::numeric_limits<double>::max());
+    for (auto const &Pos : aPoints)
+        {
+        for (unsigned nAxis = 0; nAxis < 3; ++nAxis)
+            {
+            Min[nAxis] = std::min(Min[nAxis], Pos[nAxis]);
+            Max[nAxis] = std::max(Max[nAxis], Pos[nAxis]);
+            }
+        }
+    double dExtent = std::max(Max.m_x-Min.m_x, std::max(Max.m_y-Min.m_y, Max.m_z-Min.m_z));
+    const double dMaxCell = (double)((1u << KEY_BITS_PER_AXIS) - 1);
+    double dScale = dExtent > 0.0 ? dMaxCell / dExtent : 0.0;
+    for (size_t i = 0; i < nPoints; ++i)
+        {
+        SGM::Point3D const &Pos = aPoints[i];
+        unsigned aCell[3];
+        for (unsigned nAxis = 0; nAxis < 3; ++nAxis)
+            {
+            aCell[nAxis] = (unsigned)std::min(dMaxCell, (Pos[nAxis] - Min[nAxis]) * dScale);
+            }
+        aKeys[i] = KeyFunction(aCell[0], aCell[1], aCell[2]);
+        }
+    }
+
+// Order the points by the keys made by KeyFunction and then order the
+// runs of equal keys by the exact floating point Z-order.
+
+template <class KEY_FUNCTION>
+buffer<unsigned> OrderPointsByKey(std::vector<SGM::Point3D> const &aPoints,
+                                  KEY_FUNCTION                     KeyFunction)
+    {
+    size_t nPoints = aPoints.size();
+    buffer<unsigned> aIndexOrdered(nPoints);
+    std::iota(aIndexOrdered.begin(), aIndexOrdered.end(), 0);
+    if (nPoints < 2)
+        {
+        return aIndexOrdered;
+        }
+    buffer<uint64_t> aKeys(nPoints);
+    FindQuantizedKeys(aPoints, KeyFunction, aKeys);
+    RadixSortKeys(aKeys, aIndexOrdered);
 
     SGM::Point3D const *pPoints = aPoints.data();
-    unsigned *pIndexOrdered = aIndexOrdered.data();
-    Point3DSeparate *pPointSeparates = new Point3DSeparate[aPoints.size()];
-
-    // Make a version of points separated into mantissa and exponent
-    // and fill an array with range [0,nPoints-1]
-
-//#if defined(SGM_MULTITHREADED)
-//#else
-    CreatePoint3DSeparates(pPoints,0,aPoints.size(),pPointSeparates,pIndexOrdered);
-//#endif
-
-    // Sort the index array using our Less function for pairs of Point3D and Point3DSeparate
-#if defined(SGM_MULTITHREADED) && !defined(_MSC_VER)
-    parallel_sort(aIndexOrdered.begin(),
-            aIndexOrdered.end(),
-            [&pPoints,&pPointSeparates](unsigned i, unsigned j) {
-                return LessZOrder(pPoints[i], pPointSeparates[i], pPoints[j], pPointSeparates[j]);
-            });
-#else
-    std::sort(aIndexOrdered.begin(),
-              aIndexOrdered.end(),
-              [&pPoints,&pPointSeparates](unsigned i, unsigned j) {
-                  return LessZOrder(pPoints[i], pPointSeparates[i], pPoints[j], pPointSeparates[j]);
-                  });
-#endif
-    delete[] pPointSeparates;
+    size_t iBegin = 0;
+    while (iBegin < nPoints)
+        {
+        size_t iEnd = iBegin + 1;
+        while (iEnd < nPoints && aKeys[iEnd] == aKeys[iBegin])
+            {
+            ++iEnd;
+            }
+        if (iEnd - iBegin > 1)
+            {
+            std::vector<Point3DSeparate> aSeparates;
+            aSeparates.reserve(iEnd - iBegin);
+            for (size_t i = iBegin; i < iEnd; ++i)
+                {
+                aSeparates.emplace_back(pPoints[aIndexOrdered[i]]);
+                }
+            std::vector<unsigned> aRun(iEnd - iBegin);
+            std::iota(aRun.begin(), aRun.end(), 0);
+            std::stable_sort(aRun.begin(), aRun.end(),
+                             [&](unsigned i, unsigned j) {
+                                 return LessZOrder(pPoints[aIndexOrdered[iBegin+i]], aSeparates[i],
+                                                   pPoints[aIndexOrdered[iBegin+j]], aSeparates[j]);
+                             });
+            std::vector<unsigned> aOld(aIndexOrdered.begin() + iBegin, aIndexOrdered.begin() + iEnd);
+            for (size_t i = 0; i < aRun.size(); ++i)
+                {
+                aIndexOrdered[iBegin+i] = aOld[aRun[i]];
+                }
+            }
+        iBegin = iEnd;
+        }
     return aIndexOrdered;
     }
 
+buffer<unsigned> OrderPointsMorton(std::vector<SGM::Point3D> const &aPoints)
+    {
+    return OrderPointsByKey(aPoints, MortonKey);
+    }
+
+buffer<unsigned> OrderPointsHilbert(std::vector<SGM::Point3D> const &aPoints)
+    {
+    return OrderPointsByKey(aPoints, HilbertKey);
+    }
 
 } // namespace SGMInternal
\ No newline at end of file
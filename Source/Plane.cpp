@@ -7,6 +7,7 @@
 #include "EntityClasses.h"
 #include "Surface.h"
 #include "Curve.h"
+#include "Util/profile.h"
 
 namespace SGMInternal
 {
@@ -106,6 +107,8 @@ void plane::Evaluate(SGM::Point2D const &uv,
                      SGM::Vector3D      *Duv,
                      SGM::Vector3D      *Dvv) const
     {
+    SGM_PROFILE_COUNT(ProfileSurfaceEvaluate);
+
     if(Pos)
         {
         Pos->m_x=m_Origin.m_x+(m_XAxis.X()*uv.m_u+m_YAxis.X()*uv.m_v);
@@ -152,6 +155,8 @@ SGM::Point2D plane::Inverse(SGM::Point3D const &Pos,
                             SGM::Point3D       *ClosePos,
                             SGM::Point2D const *) const
     {
+    SGM_PROFILE_COUNT(ProfileSurfaceInverse);
+
         double dx=Pos.m_x-m_Origin.m_x;
         double dy=Pos.m_y-m_Origin.m_y;
         double dz=Pos.m_z-m_Origin.m_z;
@@ -662,102 +662,167 @@ bool BridgePolygon(std::vector<SGM::Point2D> const &aPoints,
     return bAnswer;
     }
 
-inline unsigned GetPrevious(unsigned                 nEar,
-                            std::vector<bool> const &aCutOff)
+// ReflexGrid is a uniform grid over the bounding rectangle of a polygon
+// that holds the positions of the polygon vertices that are not convex.
+// Only those vertices can be inside of a convex ear, so ear clipping
+// only has to look at the grid cells under the bounding rectangle of a
+// candidate ear instead of at every vertex of the polygon.
+
+class ReflexGrid
+    {
+public:
+
+    ReflexGrid(std::vector<SGM::Point2D> const &aPoints,
+               std::vector<unsigned>     const &aPolygon);
+
+    void Insert(unsigned nWhere);
+
+    void Remove(unsigned nWhere);
+
+    // Returns true if a vertex of the grid, other than the given ear points,
+    // is inside the triangle (nEarA,nEarB,nEarC), and returns the polygon
+    // position of that vertex in nBlocker.
+
+    bool FindInside(unsigned  nEarA,
+                    unsigned  nEarB,
+                    unsigned  nEarC,
+                    unsigned &nBlocker) const;
+
+private:
+
+    size_t FindCell(SGM::Point2D const &Pos) const;
+
+    void FindCellRange(double  dMin,
+                       double  dMax,
+                       double  dStart,
+                       double  dCellSize,
+                       size_t  nCells,
+                       size_t &nFirst,
+                       size_t &nLast) const;
+
+    std::vector<SGM::Point2D>           const &m_aPoints;
+    std::vector<unsigned>               const &m_aPolygon;
+    std::vector<std::vector<unsigned> >        m_aaCells;
+    SGM::Point2D                               m_Min;
+    double                                     m_dCellU;
+    double                                     m_dCellV;
+    size_t                                     m_nCellsU;
+    size_t                                     m_nCellsV;
+    };
+
+ReflexGrid::ReflexGrid(std::vector<SGM::Point2D> const &aPoints,
+                       std::vector<unsigned>     const &aPolygon):
+    m_aPoints(aPoints),m_aPolygon(aPolygon)
     {
-    unsigned nAnswer=nEar;
-    unsigned nPolygon=(unsigned)aCutOff.size();
-    for(unsigned Index1=1;Index1<nPolygon;++Index1)
+    SGM::Interval2D Box(aPoints[aPolygon[0]]);
+    for(auto nPoint : aPolygon)
         {
-        nAnswer=(nEar+nPolygon-Index1)%nPolygon;
-        if(aCutOff[nAnswer]==false)
-            {
-            break;
-            }
+        Box+=SGM::Interval2D(aPoints[nPoint]);
         }
-    return nAnswer;
+    size_t nCells=(size_t)std::sqrt((double)aPolygon.size())+1;
+    m_nCellsU=nCells;
+    m_nCellsV=nCells;
+    m_Min=SGM::Point2D(Box.m_UDomain.m_dMin,Box.m_VDomain.m_dMin);
+    m_dCellU=std::max(Box.m_UDomain.Length()/(double)nCells,SGM_MIN_TOL);
+    m_dCellV=std::max(Box.m_VDomain.Length()/(double)nCells,SGM_MIN_TOL);
+    m_aaCells.resize(m_nCellsU*m_nCellsV);
     }
 
-inline unsigned GetNext(unsigned                 nEar,
-                        std::vector<bool> const &aCutOff)
+inline void ReflexGrid::FindCellRange(double  dMin,
+                                      double  dMax,
+                                      double  dStart,
+                                      double  dCellSize,
+                                      size_t  nCells,
+                                      size_t &nFirst,
+                                      size_t &nLast) const
     {
-    unsigned nAnswer=nEar;
-    unsigned nPolygon=(unsigned)aCutOff.size();
-    for(unsigned Index1=1;Index1<nPolygon;++Index1)
-        {
-        nAnswer=(nEar+Index1)%nPolygon;
-        if(aCutOff[nAnswer]==false)
-            {
-            break;
-            }
-        }
-    return nAnswer;
+    double dFirst=std::floor((dMin-dStart)/dCellSize);
+    double dLast=std::floor((dMax-dStart)/dCellSize);
+    nFirst=dFirst<0 ? 0 : std::min((size_t)dFirst,nCells-1);
+    nLast=dLast<0 ? 0 : std::min((size_t)dLast,nCells-1);
+    }
+
+inline size_t ReflexGrid::FindCell(SGM::Point2D const &Pos) const
+    {
+    size_t nU,nV,nNotUsed;
+    FindCellRange(Pos.m_u,Pos.m_u,m_Min.m_u,m_dCellU,m_nCellsU,nU,nNotUsed);
+    FindCellRange(Pos.m_v,Pos.m_v,m_Min.m_v,m_dCellV,m_nCellsV,nV,nNotUsed);
+    return nU+nV*m_nCellsU;
     }
 
-inline bool GoodEar(std::vector<SGM::Point2D> const &aPoints,
-                    std::vector<unsigned>           &aPolygon,
-                    std::vector<bool>         const &aCutOff,
-                    unsigned                         nEar,
-                    unsigned                         nEarA,
-                    unsigned                         nEarB,
-                    unsigned                         nEarC)
+void ReflexGrid::Insert(unsigned nWhere)
     {
-    if(aCutOff[nEar])
+    m_aaCells[FindCell(m_aPoints[m_aPolygon[nWhere]])].push_back(nWhere);
+    }
+
+void ReflexGrid::Remove(unsigned nWhere)
+    {
+    std::vector<unsigned> &aCell=m_aaCells[FindCell(m_aPoints[m_aPolygon[nWhere]])];
+    auto iter=std::find(aCell.begin(),aCell.end(),nWhere);
+    if(iter!=aCell.end())
         {
-        return false;
+        *iter=aCell.back();
+        aCell.pop_back();
         }
-    unsigned nPolygon=(unsigned)aPolygon.size();
-
-    SGM::TriangleData2D Triangle(aPoints[nEarA],aPoints[nEarB],aPoints[nEarC]);
+    }
 
-    for(unsigned Index1 = 0; Index1 < nPolygon; ++Index1)
+bool ReflexGrid::FindInside(unsigned  nEarA,
+                            unsigned  nEarB,
+                            unsigned  nEarC,
+                            unsigned &nBlocker) const
+    {
+    SGM::Point2D const &PosA=m_aPoints[nEarA];
+    SGM::Point2D const &PosB=m_aPoints[nEarB];
+    SGM::Point2D const &PosC=m_aPoints[nEarC];
+    SGM::TriangleData2D Triangle(PosA,PosB,PosC);
+    double dMinU=std::min(PosA.m_u,std::min(PosB.m_u,PosC.m_u))-SGM_MIN_TOL;
+    double dMaxU=std::max(PosA.m_u,std::max(PosB.m_u,PosC.m_u))+SGM_MIN_TOL;
+    double dMinV=std::min(PosA.m_v,std::min(PosB.m_v,PosC.m_v))-SGM_MIN_TOL;
+    double dMaxV=std::max(PosA.m_v,std::max(PosB.m_v,PosC.m_v))+SGM_MIN_TOL;
+    size_t nFirstU,nLastU,nFirstV,nLastV;
+    FindCellRange(dMinU,dMaxU,m_Min.m_u,m_dCellU,m_nCellsU,nFirstU,nLastU);
+    FindCellRange(dMinV,dMaxV,m_Min.m_v,m_dCellV,m_nCellsV,nFirstV,nLastV);
+    for(size_t nV=nFirstV;nV<=nLastV;++nV)
         {
-        unsigned nPos=aPolygon[Index1];
-        if (nPos!=nEarA && nPos!=nEarB && nPos!=nEarC)
+        for(size_t nU=nFirstU;nU<=nLastU;++nU)
             {
-            if(Triangle.InTriangle(aPoints[nPos])==true)
+            for(auto nWhere : m_aaCells[nU+nV*m_nCellsU])
                 {
-                return false;
+                unsigned nPos=m_aPolygon[nWhere];
+                if(nPos!=nEarA && nPos!=nEarB && nPos!=nEarC)
+                    {
+                    SGM::Point2D const &Pos=m_aPoints[nPos];
+                    if( dMinU<=Pos.m_u && Pos.m_u<=dMaxU &&
+                        dMinV<=Pos.m_v && Pos.m_v<=dMaxV &&
+                        Triangle.InTriangle(Pos))
+                        {
+                        nBlocker=nWhere;
+                        return true;
+                        }
+                    }
                 }
             }
         }
-
-    return true;
+    return false;
     }
 
+// Returns the angle value used to order the ears of a polygon.  Convex
+// vertices return one minus the cosine of their angle, and vertices that
+// are not convex return 10.
+
 double FindAngle(std::vector<SGM::Point2D> const &aPoints,
                  std::vector<unsigned>     const &aPolygon,
-                 std::vector<bool>         const &aCutOff,
-                 unsigned                         nB)
+                 unsigned                         nA,
+                 unsigned                         nB,
+                 unsigned                         nC)
     {
-    unsigned nA=0,nC=0;
-    unsigned nPolygon=(unsigned)aPolygon.size();
-    unsigned Index1;
-    for(Index1=1;Index1<nPolygon;++Index1)
-        {
-        unsigned nWhere=(nB+Index1)%nPolygon;
-        if(aCutOff[nWhere]==false)
-            {
-            nC=nWhere;
-            break;
-            }
-        }
-    for(Index1=1;Index1<nPolygon;++Index1)
-        {
-        unsigned nWhere=(nB+nPolygon-Index1)%nPolygon;
-        if(aCutOff[nWhere]==false)
-            {
-            nA=nWhere;
-            break;
-            }
-        }
     SGM::Point2D const &PosA=aPoints[aPolygon[nA]];
     SGM::Point2D const &PosB=aPoints[aPolygon[nB]];
     SGM::Point2D const &PosC=aPoints[aPolygon[nC]];
     SGM::UnitVector2D VecAB=PosA-PosB;
     SGM::UnitVector2D VecCB=PosC-PosB;
     double dUp=VecAB.V()*VecCB.U()-VecAB.U()*VecCB.V();
-    if(dUp<SGM_ZERO)
+    if(dUp<SGM_ZERO)  // Check to make sure that the angle is less than 180 degrees.
         {
         return 10;
         }
@@ -767,6 +832,26 @@ double FindAngle(std::vector<SGM::Point2D> const &aPoints,
         }
     }
 
+// A reflex ear is only tried when no convex ear can be cut off, which only
+// happens on degenerate polygons, so it is checked against every vertex.
+
+bool GoodReflexEar(std::vector<SGM::Point2D> const &aPoints,
+                   std::vector<unsigned>     const &aPolygon,
+                   unsigned                         nEarA,
+                   unsigned                         nEarB,
+                   unsigned                         nEarC)
+    {
+    SGM::TriangleData2D Triangle(aPoints[nEarA],aPoints[nEarB],aPoints[nEarC]);
+    for(auto nPos : aPolygon)
+        {
+        if(nPos!=nEarA && nPos!=nEarB && nPos!=nEarC && Triangle.InTriangle(aPoints[nPos]))
+            {
+            return false;
+            }
+        }
+    return true;
+    }
+
 void TriangulatePolygonSubSub(std::vector<SGM::Point2D> const &aPoints,
                               std::vector<unsigned>           &aInPolygon,
                               std::vector<unsigned>           &aTriangles,
@@ -775,6 +860,12 @@ void TriangulatePolygonSubSub(std::vector<SGM::Point2D> const &aPoints,
     // Find and cut off ears with the smallest angle first.
     // First find the angle of each vertex of the polygon.
     // Then cut off the nPolygon-3 ears.
+    //
+    // The polygon is kept as a doubly linked list, the vertices that are not
+    // convex are kept in a ReflexGrid, and an ear that is blocked by a vertex
+    // is parked on that vertex until the vertex is cut off or becomes convex.
+    // Hence, each ear is only tested when something that can change the test
+    // has changed.
 
     std::vector<unsigned> aPolygon;
     if(bSelfIntersect)
@@ -785,38 +876,76 @@ void TriangulatePolygonSubSub(std::vector<SGM::Point2D> const &aPoints,
         {
         aPolygon=aInPolygon;
         }
-    size_t Index1;
-    size_t nPolygon = aPolygon.size();
+    unsigned Index1;
+    unsigned nPolygon=(unsigned)aPolygon.size();
     if(nPolygon<3)
         {
         return;
         }
-    std::vector<bool> aCutOff;
-    aCutOff.assign(nPolygon, false);
+    std::vector<bool> aCutOff(nPolygon,false);
+    std::vector<bool> aParked(nPolygon,false);
+    std::vector<unsigned> aPrevious(nPolygon),aNext(nPolygon);
+    std::vector<std::vector<unsigned> > aaParkedOn(nPolygon);
     aTriangles.reserve(3 * (nPolygon - 2));
     std::set<std::pair<double, unsigned> > sAngles;
     std::vector<double> aAngles;
     aAngles.reserve(nPolygon);
+    ReflexGrid Grid(aPoints,aPolygon);
     for (Index1 = 0; Index1 < nPolygon; ++Index1)
         {
-        SGM::Point2D const &PosA = aPoints[aPolygon[(Index1 + nPolygon - 1) % nPolygon]];
-        SGM::Point2D const &PosB = aPoints[aPolygon[Index1]];
-        SGM::Point2D const &PosC = aPoints[aPolygon[(Index1 + 1) % nPolygon]];
-        SGM::UnitVector2D VecAB = PosA - PosB;
-        SGM::UnitVector2D VecCB = PosC - PosB;
-        double dUp = VecAB.V() * VecCB.U() - VecAB.U() * VecCB.V();
-        if( dUp < SGM_ZERO )  // Check to make sure that the angle is less than 180 degrees.
+        aPrevious[Index1]=(Index1+nPolygon-1)%nPolygon;
+        aNext[Index1]=(Index1+1)%nPolygon;
+        double dAngle=FindAngle(aPoints,aPolygon,aPrevious[Index1],Index1,aNext[Index1]);
+        sAngles.insert(std::pair<double, unsigned>(dAngle, Index1));
+        aAngles.push_back(dAngle);
+        if(dAngle==10.0)
             {
-            sAngles.insert(std::pair<double, unsigned>(10.0, (unsigned)Index1));
-            aAngles.push_back(10.0);
+            Grid.Insert(Index1);
+            }
+        }
+
+    // Returns the ears that were parked on nWhere to the set of angles.
+
+    auto Release=[&](unsigned nWhere)
+        {
+        for(auto nParked : aaParkedOn[nWhere])
+            {
+            if(aParked[nParked] && !aCutOff[nParked])
+                {
+                aParked[nParked]=false;
+                sAngles.insert(std::pair<double, unsigned>(aAngles[nParked],nParked));
+                }
+            }
+        aaParkedOn[nWhere].clear();
+        };
+
+    // Updates the angle at nWhere after one of its neighbors has been cut off.
+
+    auto Update=[&](unsigned nWhere)
+        {
+        double dOldAngle=aAngles[nWhere];
+        double dNewAngle=FindAngle(aPoints,aPolygon,aPrevious[nWhere],nWhere,aNext[nWhere]);
+        if(aParked[nWhere])
+            {
+            aParked[nWhere]=false;
             }
         else
             {
-            double dAngle = 1.0 - VecAB % VecCB;
-            sAngles.insert(std::pair<double, unsigned>(dAngle, (unsigned)Index1));
-            aAngles.push_back(dAngle);
+            sAngles.erase(std::pair<double, unsigned>(dOldAngle,nWhere));
             }
-        }
+        sAngles.insert(std::pair<double, unsigned>(dNewAngle,nWhere));
+        aAngles[nWhere]=dNewAngle;
+        if(dOldAngle==10.0 && dNewAngle!=10.0)
+            {
+            Grid.Remove(nWhere);
+            Release(nWhere);
+            }
+        else if(dOldAngle!=10.0 && dNewAngle==10.0)
+            {
+            Grid.Insert(nWhere);
+            }
+        };
+
     for(Index1=0;Index1<nPolygon-2;++Index1)
         {
         auto iter = sAngles.begin();
@@ -825,44 +954,55 @@ void TriangulatePolygonSubSub(std::vector<SGM::Point2D> const &aPoints,
             std::pair<double, unsigned> Angle = *iter;
             unsigned nEar = Angle.second;
 
-            unsigned nPreviousEarA = GetPrevious(nEar, aCutOff);
-            unsigned nNextEarC = GetNext(nEar, aCutOff);
+            unsigned nPreviousEarA = aPrevious[nEar];
+            unsigned nNextEarC = aNext[nEar];
             unsigned nEarA = aPolygon[nPreviousEarA];
             unsigned nEarB = aPolygon[nEar];
             unsigned nEarC = aPolygon[nNextEarC];
 
-            if (GoodEar(aPoints, aPolygon, aCutOff, nEar, nEarA, nEarB, nEarC))
-            {
+            bool bGoodEar;
+            if(Angle.first==10.0)
+                {
+                bGoodEar=GoodReflexEar(aPoints,aPolygon,nEarA,nEarB,nEarC);
+                }
+            else
+                {
+                unsigned nBlocker;
+                bGoodEar=!Grid.FindInside(nEarA,nEarB,nEarC,nBlocker);
+                if(!bGoodEar)
+                    {
+                    aParked[nEar]=true;
+                    aaParkedOn[nBlocker].push_back(nEar);
+                    iter=sAngles.erase(iter);
+                    continue;
+                    }
+                }
+
+            if (bGoodEar)
+                {
                 aTriangles.push_back(nEarA);
                 aTriangles.push_back(nEarB);
                 aTriangles.push_back(nEarC);
 
-                // Fix angles at nEar
+                // Remove nEar from the polygon.
 
-                sAngles.erase(Angle);
-                Angle.first = 10;
-                sAngles.insert(Angle);
-                aAngles[nEar] = 10;
+                sAngles.erase(iter);
+                if(Angle.first==10.0)
+                    {
+                    Grid.Remove(nEar);
+                    }
                 aCutOff[nEar] = true;
+                aNext[nPreviousEarA]=nNextEarC;
+                aPrevious[nNextEarC]=nPreviousEarA;
+                Release(nEar);
 
-                // Fix angles at nEarA
-
-                std::pair<double, unsigned> AngleA(aAngles[nPreviousEarA], nPreviousEarA);
-                sAngles.erase(AngleA);
-                AngleA.first = FindAngle(aPoints, aPolygon, aCutOff, nPreviousEarA);
-                sAngles.insert(AngleA);
-                aAngles[nPreviousEarA] = AngleA.first;
+                // Fix angles at nEarA and nEarC
 
-                // Fix angles at nEarC
-
-                std::pair<double, unsigned> AngleC(aAngles[nNextEarC], nNextEarC);
-                sAngles.erase(AngleC);
-                AngleC.first = FindAngle(aPoints, aPolygon, aCutOff, nNextEarC);
-                sAngles.insert(AngleC);
-                aAngles[nNextEarC] = AngleC.first;
+                Update(nPreviousEarA);
+                Update(nNextEarC);
 
                 break;
-            }
+                }
             ++iter;
             }
         }
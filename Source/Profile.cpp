@@ -0,0 +1,284 @@
+#include "SGMProfile.h"
+
+#include "Util/profile.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <iomanip>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Profiling Functions
+//
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Private SGMInternal implementation
+//
+///////////////////////////////////////////////////////////////////////////////
+
+namespace SGMInternal
+{
+
+std::atomic<bool> g_bProfiling(false);
+
+static char const *ProfileCounterNames[ProfileCounterCount] =
+    {
+    "SurfaceEvaluate",
+    "SurfaceInverse",
+    "PointInFace",
+    "IntersectLineAndSurface",
+    "FacetFace"
+    };
+
+struct ProfileEvent
+    {
+    char const *m_sName;
+    int64_t     m_nStart;    // nanoseconds since the profile epoch
+    int64_t     m_nDuration; // nanoseconds, -1 while the zone is open
+    unsigned    m_nDepth;
+    };
+
+// The events and counts of one thread.  Only the owning thread writes to a
+// buffer, and buffers live until the end of the program so that they can be
+// read after their thread has finished.
+
+struct ProfileThreadBuffer
+    {
+    explicit ProfileThreadBuffer(unsigned nThread) :
+        m_nThread(nThread), m_aCounts() {}
+
+    unsigned              m_nThread;
+    std::vector<ProfileEvent> m_aEvents;
+    std::vector<size_t>   m_aOpen;
+    size_t                m_aCounts[ProfileCounterCount];
+    };
+
+struct ProfileRegistry
+    {
+    ProfileRegistry() : m_Epoch(std::chrono::steady_clock::now()) {}
+
+    std::mutex                                         m_Mutex;
+    std::vector<std::unique_ptr<ProfileThreadBuffer> > m_aBuffers;
+    std::chrono::steady_clock::time_point              m_Epoch;
+    };
+
+static ProfileRegistry &GetProfileRegistry()
+    {
+    static ProfileRegistry Registry;
+    return Registry;
+    }
+
+static ProfileThreadBuffer &GetThreadBuffer()
+    {
+    static thread_local ProfileThreadBuffer *pBuffer = nullptr;
+    if (pBuffer == nullptr)
+        {
+        ProfileRegistry &Registry = GetProfileRegistry();
+        std::lock_guard<std::mutex> Lock(Registry.m_Mutex);
+        Registry.m_aBuffers.emplace_back(new ProfileThreadBuffer((unsigned)Registry.m_aBuffers.size()));
+        pBuffer = Registry.m_aBuffers.back().get();
+        }
+    return *pBuffer;
+    }
+
+static int64_t ProfileNow()
+    {
+    auto Elapsed = std::chrono::steady_clock::now() - GetProfileRegistry().m_Epoch;
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Elapsed).count();
+    }
+
+void ProfileBegin(char const *sName)
+    {
+    ProfileThreadBuffer &Buffer = GetThreadBuffer();
+    Buffer.m_aOpen.push_back(Buffer.m_aEvents.size());
+    Buffer.m_aEvents.push_back({sName, ProfileNow(), -1, (unsigned)Buffer.m_aOpen.size()-1});
+    }
+
+void ProfileEnd()
+    {
+    ProfileThreadBuffer &Buffer = GetThreadBuffer();
+    if (!Buffer.m_aOpen.empty())
+        {
+        ProfileEvent &Event = Buffer.m_aEvents[Buffer.m_aOpen.back()];
+        Event.m_nDuration = ProfileNow() - Event.m_nStart;
+        Buffer.m_aOpen.pop_back();
+        }
+    }
+
+void ProfileCount(ProfileCounter nCounter)
+    {
+    ++GetThreadBuffer().m_aCounts[nCounter];
+    }
+
+// Writes a string as a JSON string value.
+
+static void WriteJSONString(FILE *pFile, char const *sString)
+    {
+    fputc('"', pFile);
+    for (char const *pChar = sString; *pChar; ++pChar)
+        {
+        if (*pChar == '"' || *pChar == '\\')
+            {
+            fputc('\\', pFile);
+            }
+        fputc(*pChar, pFile);
+        }
+    fputc('"', pFile);
+    }
+
+} // namespace SGMInternal
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Public SGM function implementations
+//
+///////////////////////////////////////////////////////////////////////////////
+
+namespace SGM
+{
+
+void Result::SetProfiling(bool bTurnOn)
+    {
+    SGMInternal::g_bProfiling.store(bTurnOn, std::memory_order_relaxed);
+    }
+
+bool Result::GetProfiling() const
+    {
+    return SGMInternal::IsProfiling();
+    }
+
+void ClearProfile(SGM::Result &)
+    {
+    SGMInternal::ProfileRegistry &Registry = SGMInternal::GetProfileRegistry();
+    std::lock_guard<std::mutex> Lock(Registry.m_Mutex);
+    for (auto &pBuffer : Registry.m_aBuffers)
+        {
+        pBuffer->m_aEvents.clear();
+        pBuffer->m_aOpen.clear();
+        std::fill(pBuffer->m_aCounts, pBuffer->m_aCounts+SGMInternal::ProfileCounterCount, 0);
+        }
+    }
+
+bool WriteProfileTrace(SGM::Result       &rResult,
+                       std::string const &sFileName)
+    {
+    FILE *pFile = fopen(sFileName.c_str(), "wt");
+    if (pFile == nullptr)
+        {
+        rResult.SetResult(SGM::ResultTypeFileOpen);
+        rResult.SetMessage(sFileName);
+        return false;
+        }
+    SGMInternal::ProfileRegistry &Registry = SGMInternal::GetProfileRegistry();
+    std::lock_guard<std::mutex> Lock(Registry.m_Mutex);
+    fprintf(pFile, "{\"traceEvents\":[\n");
+    bool bFirst = true;
+    for (auto &pBuffer : Registry.m_aBuffers)
+        {
+        for (auto const &Event : pBuffer->m_aEvents)
+            {
+            if (Event.m_nDuration < 0)
+                {
+                continue;
+                }
+            fprintf(pFile, bFirst ? "{\"name\":" : ",\n{\"name\":");
+            SGMInternal::WriteJSONString(pFile, Event.m_sName);
+            fprintf(pFile, ",\"cat\":\"SGM\",\"ph\":\"X\",\"pid\":0,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+                    pBuffer->m_nThread, Event.m_nStart*1e-3, Event.m_nDuration*1e-3);
+            bFirst = false;
+            }
+        for (unsigned nCounter = 0; nCounter < SGMInternal::ProfileCounterCount; ++nCounter)
+            {
+            if (pBuffer->m_aCounts[nCounter])
+                {
+                fprintf(pFile, bFirst ? "{\"name\":" : ",\n{\"name\":");
+                SGMInternal::WriteJSONString(pFile, SGMInternal::ProfileCounterNames[nCounter]);
+                fprintf(pFile, ",\"cat\":\"SGM\",\"ph\":\"C\",\"pid\":0,\"tid\":%u,\"ts\":0,\"args\":{\"calls\":%zu}}",
+                        pBuffer->m_nThread, pBuffer->m_aCounts[nCounter]);
+                bFirst = false;
+                }
+            }
+        }
+    fprintf(pFile, "\n],\"displayTimeUnit\":\"ms\"}\n");
+    fclose(pFile);
+    return true;
+    }
+
+std::string GetProfileSummary(SGM::Result &rResult)
+    {
+    struct ZoneTotal
+        {
+        size_t  m_nCalls;
+        int64_t m_nTime;
+        };
+    std::map<std::string,ZoneTotal> mZones;
+    {
+    SGMInternal::ProfileRegistry &Registry = SGMInternal::GetProfileRegistry();
+    std::lock_guard<std::mutex> Lock(Registry.m_Mutex);
+    for (auto &pBuffer : Registry.m_aBuffers)
+        {
+        for (auto const &Event : pBuffer->m_aEvents)
+            {
+            if (Event.m_nDuration >= 0)
+                {
+                ZoneTotal &Total = mZones[Event.m_sName];
+                ++Total.m_nCalls;
+                Total.m_nTime += Event.m_nDuration;
+                }
+            }
+        }
+    }
+
+    std::vector<std::pair<std::string,ZoneTotal> > aZones(mZones.begin(), mZones.end());
+    std::stable_sort(aZones.begin(), aZones.end(),
+                     [](std::pair<std::string,ZoneTotal> const &a, std::pair<std::string,ZoneTotal> const &b)
+                         { return b.second.m_nTime < a.second.m_nTime; });
+
+    std::ostringstream Stream;
+    Stream << std::left << std::setw(40) << "Zone"
+           << std::right << std::setw(12) << "Calls"
+           << std::setw(16) << "Total (ms)"
+           << std::setw(16) << "Average (ms)" << '\n';
+    Stream << std::fixed << std::setprecision(3);
+    for (auto const &Zone : aZones)
+        {
+        double dTotal = Zone.second.m_nTime*1e-6;
+        Stream << std::left << std::setw(40) << Zone.first
+               << std::right << std::setw(12) << Zone.second.m_nCalls
+               << std::setw(16) << dTotal
+               << std::setw(16) << dTotal/(double)Zone.second.m_nCalls << '\n';
+        }
+    Stream << '\n' << std::left << std::setw(40) << "Counter" << std::right << std::setw(12) << "Calls" << '\n';
+    for (auto const &Count : GetProfileCounts(rResult))
+        {
+        Stream << std::left << std::setw(40) << Count.first << std::right << std::setw(12) << Count.second << '\n';
+        }
+    return Stream.str();
+    }
+
+std::map<std::string,size_t> GetProfileCounts(SGM::Result &)
+    {
+    std::map<std::string,size_t> mCounts;
+    SGMInternal::ProfileRegistry &Registry = SGMInternal::GetProfileRegistry();
+    std::lock_guard<std::mutex> Lock(Registry.m_Mutex);
+    for (unsigned nCounter = 0; nCounter < SGMInternal::ProfileCounterCount; ++nCounter)
+        {
+        size_t nTotal = 0;
+        for (auto &pBuffer : Registry.m_aBuffers)
+            {
+            nTotal += pBuffer->m_aCounts[nCounter];
+            }
+        mCounts[SGMInternal::ProfileCounterNames[nCounter]] = nTotal;
+        }
+    return mCounts;
+    }
+
+} // End of SGM namespace
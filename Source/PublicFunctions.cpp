@@ -1485,6 +1485,26 @@ SGM::Entity SGM::CopyEntity(SGM::Result       &rResult,
     return {SGMInternal::CopyEntity(rResult,pEntity)->GetID()};
     }
 
+SGM::Reference SGM::CreateReference(SGM::Result            &rResult,
+                                    SGM::Body        const &BodyID,
+                                    SGM::Transform3D const &Trans)
+    {
+    SGMInternal::thing *pThing=rResult.GetThing();
+    auto pBody=(SGMInternal::body *)pThing->FindEntity(BodyID.m_ID);
+    return {(new SGMInternal::reference(rResult,pBody,Trans))->GetID()};
+    }
+
+SGM::Body SGM::GetReferenceBody(SGM::Result          &rResult,
+                                SGM::Reference const &ReferenceID,
+                                SGM::Transform3D     &Trans)
+    {
+    SGMInternal::thing *pThing=rResult.GetThing();
+    auto pReference=(SGMInternal::reference const *)pThing->FindEntity(ReferenceID.m_ID);
+    Trans=pReference->GetTransform();
+    SGMInternal::body *pBody=pReference->GetBody();
+    return {pBody ? pBody->GetID() : 0};
+    }
+
 void SGM::TransformEntity(SGM::Result            &rResult,
                           SGM::Transform3D const &Trans,
                           SGM::Entity            &EntityID)
@@ -11,13 +11,24 @@
 namespace SGM
     {
     
+    // How much of an entity is checked.  Each level includes the ones before it.
+
+    enum CheckLevelType
+        {
+        CheckStructureLevel,  // Pointers between entities, loops and indexes.
+        CheckGeometryLevel,   // Curve and surface evaluation tests and boxes.
+        CheckFacetLevel       // Facet normals, connectivity and sliver faces.
+        };
+
     class SGM_EXPORT CheckOptions
         {
         public:
 
             CheckOptions():
                 m_bDerivatives(false),
-                m_bEvaluaters(false) {}
+                m_bEvaluaters(false),
+                m_nLevel(CheckFacetLevel),
+                m_bOverlappingEdges(false) {}
 
             explicit CheckOptions(std::string);
 
@@ -25,8 +36,18 @@ namespace SGM
 
             bool m_bDerivatives;
             bool m_bEvaluaters;
+
+            CheckLevelType m_nLevel;       // Default is CheckFacetLevel.
+
+            bool m_bOverlappingEdges;      // Check bodies for edges that overlap.
+                                           // Default is false.
         };
 
+    // Checks the given entity and its children, or all entities if EntityID
+    // is the thing.  Check strings are returned in the order of entity IDs.
+    // With SGM_MULTITHREADED, large numbers of entities are checked in parallel
+    // after the cached data of the thing has been found.
+
     SGM_EXPORT bool CheckEntity(SGM::Result              &rResult,
                                 SGM::Entity        const &EntityID,
                                 SGM::CheckOptions  const &Options,
@@ -35,6 +35,20 @@ namespace SGM
                                     SGM::Transform3D const &Trans,
                                     SGM::Entity            &EntityID);
 
+    // Returns a reference that places the given body by Trans without
+    // copying it.  All references to a body share its geometry and facets.
+    // The body is owned by its references and is no longer top level.
+
+    SGM_EXPORT SGM::Reference CreateReference(SGM::Result            &rResult,
+                                              SGM::Body        const &BodyID,
+                                              SGM::Transform3D const &Trans);
+
+    // Returns the body of a reference, and its placement in Trans.
+
+    SGM_EXPORT SGM::Body GetReferenceBody(SGM::Result          &rResult,
+                                          SGM::Reference const &ReferenceID,
+                                          SGM::Transform3D     &Trans);
+
     SGM_EXPORT SGM::Interval3D const &GetBoundingBox(SGM::Result       &rResult,
                                                      SGM::Entity const &EntityID);
 
@@ -0,0 +1,48 @@
+#ifndef SGM_PROFILE_PUBLIC_H
+#define SGM_PROFILE_PUBLIC_H
+
+#include "SGMResult.h"
+
+#include <map>
+#include <string>
+
+#include "sgm_export.h"
+
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Profiling functions
+//
+//  Profiling is turned on with rResult.SetProfiling(true).  While it is on,
+//  the library records nested timed zones for its major operations on each
+//  thread, and counts calls to its hot kernels (surface Evaluate and Inverse,
+//  PointInFace, IntersectLineAndSurface and FacetFace).  These functions
+//  read the recorded data and should be called when no SGM work is running
+//  on other threads.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+namespace SGM
+    {
+    // Removes all recorded zones and counts.
+
+    SGM_EXPORT void ClearProfile(SGM::Result &rResult);
+
+    // Writes the recorded zones in the Chrome trace event JSON format, which
+    // may be viewed in chrome://tracing or other trace viewers.  Returns
+    // false with a ResultTypeFileOpen error if the file cannot be written.
+
+    SGM_EXPORT bool WriteProfileTrace(SGM::Result       &rResult,
+                                      std::string const &sFileName);
+
+    // Returns a table of the number of calls, total and average time of each
+    // zone name, followed by the totals of the call counters.
+
+    SGM_EXPORT std::string GetProfileSummary(SGM::Result &rResult);
+
+    // Returns the totals of the call counters over all threads.
+
+    SGM_EXPORT std::map<std::string,size_t> GetProfileCounts(SGM::Result &rResult);
+
+    } // End of SGM namespace
+
+#endif // SGM_PROFILE_PUBLIC_H
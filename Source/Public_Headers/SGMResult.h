@@ -67,6 +67,13 @@ class Result
             m_aLogEntries.push_back(nLogEntry);
             }
 
+        // Turns on or off the library wide profiling described in SGMProfile.h.
+        // The setting is shared by all Result objects and all threads.
+
+        SGM_EXPORT void SetProfiling(bool bTurnOn);
+
+        SGM_EXPORT bool GetProfiling() const;
+
         //////////////////////////////////////////////////////////////////////
         //
         // For internal use only.
@@ -27,7 +27,8 @@ namespace SGM
                 m_bVerbose(false),
                 m_bMerge(false),
                 m_bHeal(true),
-                m_bSplitFile(false)
+                m_bSplitFile(false),
+                m_bInstanceAssemblies(false)
                 {}
 
             bool m_bBinary;        // Output a binary version of the file.
@@ -65,6 +66,13 @@ namespace SGM
             bool m_bSplitFile;     // Split the file into smaller parts.
                                    // Default is false.
                                    // Used in STEP read.
+
+            bool m_bInstanceAssemblies; // Each occurrence of a part in an assembly
+                                        // is read as a reference to one shared body
+                                        // and a transform, instead of a copy of the
+                                        // body moved into place.
+                                        // Default is false.
+                                        // Used in STEP read.
         };
 
     SGM_EXPORT FileType GetFileType(std::string const &sFileName);
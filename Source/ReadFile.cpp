@@ -12,8 +12,7 @@
 #include "Modify.h"
 #include "Surface.h"
 
-//#define SGM_TIMER
-#include "Util/timer.h"
+#include "Util/profile.h"
 
 #include <fstream>
 #include <future>
@@ -1189,6 +1188,8 @@ size_t ReadStepFile(SGM::Result                  &rResult,
                     std::vector<std::string>     &aLog,
                     SGM::TranslatorOptions const &Options)
     {
+    SGM_PROFILE_ZONE("ReadStepFile");
+
     // Open the file.
     std::ifstream inputFileStream(FileName, std::ifstream::in);
     if (!inputFileStream.good())
@@ -1214,22 +1215,21 @@ size_t ReadStepFile(SGM::Result                  &rResult,
     // consume lines and push back (line,STEPLineData) into map
     size_t maxSTEPLineNumber;
 
-    SGM_TIMER_INITIALIZE();
-    SGM_TIMER_START("Parse STEP File");
+    {
+    SGM_PROFILE_ZONE("Parse STEP File");
 #ifdef SGM_MULTITHREADED
     maxSTEPLineNumber = ParseSTEPStreamConcurrent(rResult,Options,aLog,inputFileStream,mSTEPTagMap,mSTEPData);
-    SGM_TIMER_STOP();
 #else
     maxSTEPLineNumber = ParseSTEPStreamSerial(rResult,Options,aLog,inputFileStream,mSTEPTagMap,mSTEPData);
 #endif
+    }
     inputFileStream.close();
-    SGM_TIMER_SUM();
 
     // Create all the entities.
 
     if(!Options.m_bScan)
         {
-        CreateEntities(rResult,maxSTEPLineNumber,mSTEPData,aEntities);
+        CreateEntities(rResult,Options,maxSTEPLineNumber,mSTEPData,aEntities);
         }
 
 #ifdef SGM_PROFILE_READER
@@ -1237,23 +1237,43 @@ size_t ReadStepFile(SGM::Result                  &rResult,
     exit(1);
 #endif // SGM_PROFILE_READER
 
+    // Instanced assemblies are healed through their shared bodies, once each.
+
+    std::vector<entity *> aParts;
+    std::set<entity *> sReferenced;
+    for(entity *pEntity : aEntities)
+        {
+        if(pEntity->GetType()==SGM::ReferenceType)
+            {
+            body *pBody=((reference *)pEntity)->GetBody();
+            if(pBody && sReferenced.insert(pBody).second)
+                {
+                aParts.push_back(pBody);
+                }
+            }
+        else
+            {
+            aParts.push_back(pEntity);
+            }
+        }
+
     if(Options.m_bHeal)
         {
         HealOptions Options1;
-        Heal(rResult,aEntities,Options1);
+        Heal(rResult,aParts,Options1);
         }
     
-    size_t nEntities=aEntities.size();
+    size_t nParts=aParts.size();
     size_t Index1;
-    for(Index1=0;Index1<nEntities;++Index1)
+    for(Index1=0;Index1<nParts;++Index1)
         {
         if(Options.m_bMerge)
             {
-            Merge(rResult,aEntities[Index1]);
+            Merge(rResult,aParts[Index1]);
             }
-        if(aEntities[Index1]->GetType()==SGM::BodyType)
+        if(aParts[Index1]->GetType()==SGM::BodyType)
             {
-            FixVolumes(rResult,(body *)aEntities[Index1]);
+            FixVolumes(rResult,(body *)aParts[Index1]);
             }
         }
 
@@ -451,6 +451,41 @@ void ReadBody(SGM::Result              &rResult,
     mEntityMap[GetID(aArgs[0])]=rSGMData;
     }
 
+void ReadReference(SGM::Result              &rResult,
+                   std::vector<std::string> &aArgs,
+                   std::map<size_t,SGMData> &mEntityMap)
+    {
+    SGMData rSGMData;
+    ReadEntity(aArgs,rSGMData);
+    rSGMData.aIDs1.push_back(ReadEnt(aArgs,"Body"));
+    SGM::Transform3D Trans;
+    size_t nArgs=aArgs.size();
+    size_t Index1;
+    for(Index1=2;Index1+1<nArgs;++Index1)
+        {
+        if(aArgs[Index1]=="Transform")
+            {
+            std::vector<std::string> aSubArgs;
+            if(FindSubArguments(aArgs[Index1+1],aSubArgs)==16)
+                {
+                double aData[16];
+                size_t Index2;
+                for(Index2=0;Index2<16;++Index2)
+                    {
+                    aData[Index2]=GetDouble(aSubArgs[Index2]);
+                    }
+                Trans=SGM::Transform3D(SGM::Vector4D(aData[0],aData[1],aData[2],aData[3]),
+                                       SGM::Vector4D(aData[4],aData[5],aData[6],aData[7]),
+                                       SGM::Vector4D(aData[8],aData[9],aData[10],aData[11]),
+                                       SGM::Vector4D(aData[12],aData[13],aData[14],aData[15]));
+                }
+            break;
+            }
+        }
+    rSGMData.pEntity=new reference(rResult,nullptr,Trans);
+    mEntityMap[GetID(aArgs[0])]=rSGMData;
+    }
+
 void ReadComplex(SGM::Result              &rResult,
                  std::vector<std::string> &aArgs,
                  std::map<size_t,SGMData> &mEntityMap)
@@ -914,6 +949,17 @@ void ReplaceBodyIDs(body                     *pBody,
         }
     }
 
+void ReplaceReferenceIDs(reference                *pReference,
+                         SGMData                  &rSGMData,
+                         std::map<size_t,SGMData> &mEntityMap)
+    {
+    auto iter=mEntityMap.find(rSGMData.aIDs1[0]);
+    if(iter!=mEntityMap.end() && iter->second.pEntity->GetType()==SGM::BodyType)
+        {
+        pReference->SetBody((body *)iter->second.pEntity);
+        }
+    }
+
 void ReplaceVolumeIDs(SGM::Result              &rResult,
                       volume                   *pVolume,
                       SGMData                  &rSGMData,
@@ -994,6 +1040,11 @@ void ReplaceIDs(SGM::Result              &rResult,
             ReplaceBodyIDs((body *)pEntity,rSGMData,mEntityMap);
             break;
             }
+        case SGM::ReferenceType:
+            {
+            ReplaceReferenceIDs((reference *)pEntity,rSGMData,mEntityMap);
+            break;
+            }
         case SGM::VolumeType:
             {
             ReplaceVolumeIDs(rResult,(volume *)pEntity,rSGMData,mEntityMap);
@@ -1178,10 +1229,10 @@ size_t ReadSGMFile(SGM::Result                  &rResult,
         //    {
         //    ReadExtrude(rResult,aArgs,mEntityMap);
         //    }
-        //else if(aArgs[1]=="Reference")
-        //    {
-        //    ReadReference(rResult,aArgs,mEntityMap);
-        //    }
+        else if(aArgs[1]=="Reference")
+            {
+            ReadReference(rResult,aArgs,mEntityMap);
+            }
         //else if(aArgs[1]=="Assembly")
         //    {
         //    ReadAssembly(rResult,aArgs,mEntityMap);
@@ -0,0 +1,85 @@
+#include "SGMTransform.h"
+
+#include "EntityClasses.h"
+#include "Topology.h"
+
+namespace SGMInternal
+{
+
+void reference::SetBody(body *pBody)
+    {
+    if(m_pBody)
+        {
+        m_pBody->RemoveOwner(this);
+        }
+    m_pBody=pBody;
+    if(m_pBody)
+        {
+        m_pBody->AddOwner(this);
+        }
+    m_Box.Reset();
+    }
+
+void reference::SetTransform(SGM::Result            &rResult,
+                             SGM::Transform3D const &Trans)
+    {
+    m_Transform=Trans;
+    ResetBox(rResult);
+    }
+
+void reference::Transform(SGM::Result            &rResult,
+                          SGM::Transform3D const &Trans)
+    {
+    m_Transform=m_Transform*Trans;
+    ResetBox(rResult);
+    }
+
+void reference::FindAllChildren(std::set<entity *, EntityCompare> &sChildren) const
+    {
+    if(m_pBody)
+        {
+        sChildren.insert(m_pBody);
+        m_pBody->FindAllChildren(sChildren);
+        }
+    }
+
+SGM::Interval3D const &reference::GetBox(SGM::Result &rResult,bool /*bContruct*/) const
+    {
+    if(m_Box.IsEmpty() && m_pBody)
+        {
+        // Transform the eight corners of the body box, since the transform
+        // may rotate the body.
+
+        SGM::Interval3D const &BodyBox=m_pBody->GetBox(rResult);
+        if(!BodyBox.IsEmpty())
+            {
+            size_t Index1;
+            for(Index1=0;Index1<8;++Index1)
+                {
+                SGM::Point3D Corner(Index1&1 ? BodyBox.m_XDomain.m_dMax : BodyBox.m_XDomain.m_dMin,
+                                    Index1&2 ? BodyBox.m_YDomain.m_dMax : BodyBox.m_YDomain.m_dMin,
+                                    Index1&4 ? BodyBox.m_ZDomain.m_dMax : BodyBox.m_ZDomain.m_dMin);
+                m_Box.Stretch(m_Transform*Corner);
+                }
+            }
+        }
+    return m_Box;
+    }
+
+void reference::ReplacePointers(std::map<entity *,entity *> const &mEntityMap)
+    {
+    auto MapValue=mEntityMap.find(m_pBody);
+    if(MapValue!=mEntityMap.end())
+        {
+        SetBody((body *)MapValue->second);
+        }
+    OwnerAndAttributeReplacePointers(mEntityMap);
+    }
+
+void reference::SeverRelations(SGM::Result &)
+    {
+    SetBody(nullptr);
+    RemoveAllOwners();
+    }
+
+} // End of SGMInternal namespace
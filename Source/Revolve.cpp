@@ -5,6 +5,7 @@
 #include "EntityClasses.h"
 #include "Surface.h"
 #include "Curve.h"
+#include "Util/profile.h"
 
 namespace SGMInternal
 {
@@ -93,6 +94,8 @@ void revolve::Evaluate(SGM::Point2D const &uv,
                        SGM::Vector3D      *Duv,
                        SGM::Vector3D      *Dvv) const
     {
+    SGM_PROFILE_COUNT(ProfileSurfaceEvaluate);
+
     SGM::Point3D   CurvePos;
     SGM::Vector3D  DvCurve;
     SGM::Vector3D *pDvCurve = &DvCurve;
@@ -170,6 +173,8 @@ SGM::Point2D revolve::Inverse(SGM::Point3D const &Pos,
                               SGM::Point3D       *ClosePos,
                               SGM::Point2D const *pGuess) const
     { 
+    SGM_PROFILE_COUNT(ProfileSurfaceInverse);
+
     SGM::Point2D uv;
     
     uv.m_u = 0; // default u output to 0
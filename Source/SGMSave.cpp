@@ -597,6 +597,23 @@ void reference::WriteSGM(SGM::Result                  &rResult,
     {
     fprintf(pFile,"#%lu Reference",GetID());
     entity::WriteSGM(rResult,pFile,Options);
+    if(m_pBody)
+        {
+        fprintf(pFile," Body #%lu",m_pBody->GetID());
+        }
+    SGM::Vector4D const *aMatrix=m_Transform.GetData();
+    std::vector<double> aData;
+    size_t Index1;
+    for(Index1=0;Index1<4;++Index1)
+        {
+        aData.push_back(aMatrix[Index1].m_x);
+        aData.push_back(aMatrix[Index1].m_y);
+        aData.push_back(aMatrix[Index1].m_z);
+        aData.push_back(aMatrix[Index1].m_w);
+        }
+    fprintf(pFile," Transform ");
+    WriteDoubles(pFile,aData);
+    fprintf(pFile,";\n");
     }
 
 void assembly::WriteSGM(SGM::Result                  &rResult,
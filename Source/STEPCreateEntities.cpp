@@ -932,6 +932,7 @@ void InstantiateBodiesForLeafAssemblyNodes(SGM::Result &rResult,
                                            std::map<size_t, STEPContextDepShapeRepData> const &mCDSRLinks,
                                            STEPLineDataMapType                          const &mSTEPData,
                                            IDEntityMapType                              const &mIDToEntityMap,
+                                           bool                                                bInstance,
                                            BodyToTransformMapType                             &mBodyToTransforms,
                                            std::set<entity *>                                 &sEntities)
 {
@@ -943,6 +944,20 @@ void InstantiateBodiesForLeafAssemblyNodes(SGM::Result &rResult,
         body *pParentBody = nullptr;
         assert(pBody != nullptr);
 
+        if (bInstance)
+        {
+            // share the body between all of its occurrences
+            reference *pReference = new reference(rResult, pBody, ParentTransform);
+            sEntities.erase(pBody);
+            sEntities.emplace(pReference);
+            if (!AsmParentNode.Name.empty())
+            {
+                attribute *pName = new StringAttribute(rResult,"Name",AsmParentNode.Name);
+                pReference->AddAttribute(pName);
+            }
+            return;
+        }
+
         if (mBodyToTransforms.find(pBody) == mBodyToTransforms.end())
         {
             // reuse the already created body for the first instance
@@ -976,7 +991,7 @@ void InstantiateBodiesForLeafAssemblyNodes(SGM::Result &rResult,
             const STEPAssemblyNode &ChildNode = mAssemblyNodes.at(CDSRChild.ShapeRepChildID);
             InstantiateBodiesForLeafAssemblyNodes(rResult, ChildNode, transform,
                                                   mAssemblyNodes, mCDSRLinks, mSTEPData,
-                                                  mIDToEntityMap, mBodyToTransforms, sEntities);
+                                                  mIDToEntityMap, bInstance, mBodyToTransforms, sEntities);
         }
     }
 }
@@ -984,6 +999,7 @@ void InstantiateBodiesForLeafAssemblyNodes(SGM::Result &rResult,
 
 
 void FlattenAssemblies(SGM::Result &rResult,
+                    SGM::TranslatorOptions const &Options,
                     size_t maxSTEPLineNumber,
                     STEPLineDataMapType const &mSTEPData,
                     IDEntityMapType const &mIDToEntityMap,
@@ -1034,7 +1050,8 @@ void FlattenAssemblies(SGM::Result &rResult,
 
             InstantiateBodiesForLeafAssemblyNodes(rResult, AsmParentNode, transform,
                                                   mAssemblyNodes, mCDSRLinks, mSTEPData,
-                                                  mIDToEntityMap, mBodyToAssemblyTransforms, sEntities);
+                                                  mIDToEntityMap, Options.m_bInstanceAssemblies,
+                                                  mBodyToAssemblyTransforms, sEntities);
         }
     }
 
@@ -1048,10 +1065,11 @@ void FlattenAssemblies(SGM::Result &rResult,
 //
 ////////////////////////////////////////////////////////////////////////////////
 
-void CreateEntities(SGM::Result           &rResult,
-                    size_t                 maxSTEPLineNumber,
-                    STEPLineDataMapType   &mSTEPData,
-                    std::vector<entity *> &aEntities)
+void CreateEntities(SGM::Result                  &rResult,
+                    SGM::TranslatorOptions const &Options,
+                    size_t                        maxSTEPLineNumber,
+                    STEPLineDataMapType          &mSTEPData,
+                    std::vector<entity *>        &aEntities)
     {
     IDEntityMapType mIDToEntityMap;
     std::set<entity *> sEntities;
@@ -1260,7 +1278,7 @@ void CreateEntities(SGM::Result           &rResult,
 
     ApplyBodyTransforms(rResult, mBodyToTransforms);
 
-    FlattenAssemblies(rResult, maxSTEPLineNumber, mSTEPData, mIDToEntityMap, sEntities);
+    FlattenAssemblies(rResult, Options, maxSTEPLineNumber, mSTEPData, mIDToEntityMap, sEntities);
 
     // push set of entities into vector
     // TODO: could the caller just live with us returning the set? why copy to vector?
@@ -21,6 +21,42 @@ __pragma(warning(disable: 4477 ))
 
 namespace SGMInternal
 {
+// Writes the facets of a face as one STL solid, moved by pTransform if it
+// is not null.
+
+static void WriteSTLFace(SGM::Result            &rResult,
+                         FILE                   *pFile,
+                         face                   *pFace,
+                         SGM::Transform3D const *pTransform)
+    {
+    fprintf(pFile,"solid Face %lu\n",pFace->GetID());
+    std::vector<SGM::Point3D> const &aPoints=pFace->GetPoints3D(rResult);
+    std::vector<unsigned int> const &aTriangles=pFace->GetTriangles(rResult);
+    size_t Index1;
+    size_t nTriangles=aTriangles.size();
+    for(Index1=0;Index1<nTriangles;Index1+=3)
+        {
+        SGM::Point3D A=aPoints[aTriangles[Index1]];
+        SGM::Point3D B=aPoints[aTriangles[Index1+1]];
+        SGM::Point3D C=aPoints[aTriangles[Index1+2]];
+        if(pTransform)
+            {
+            A=(*pTransform)*A;
+            B=(*pTransform)*B;
+            C=(*pTransform)*C;
+            }
+        SGM::UnitVector3D Norm=(B-A)*(C-A);
+        fprintf(pFile,"   facet normal %lf %lf %lf\n",Norm.X(),Norm.Y(),Norm.Z());
+        fprintf(pFile,"      outer loop\n");
+        fprintf(pFile,"         vertex %lf %lf %lf\n",A.m_x,A.m_y,A.m_z);
+        fprintf(pFile,"         vertex %lf %lf %lf\n",B.m_x,B.m_y,B.m_z);
+        fprintf(pFile,"         vertex %lf %lf %lf\n",C.m_x,C.m_y,C.m_z);
+        fprintf(pFile,"      endloop\n");
+        fprintf(pFile,"   endfacet\n");
+        }
+    fprintf(pFile,"endsolid Face %lu\n",pFace->GetID());
+    }
+
 void SaveSTL(SGM::Result                  &rResult,
              std::string            const &FileName,
              entity                       *pEntity,
@@ -93,40 +129,43 @@ void SaveSTL(SGM::Result                  &rResult,
         ++ComplexIter;
         }
 
-    // Write out the faces.
+    // Write out the faces.  Faces of bodies that are only seen through
+    // references are written once for each reference, in its placement.
 
     std::set<face *,EntityCompare> sFaces;
-    FindFaces(rResult,pEntity,sFaces);
+    std::set<reference *,EntityCompare> sReferences;
+    if(pEntity->GetType()==SGM::ReferenceType)
+        {
+        sReferences.insert((reference *)pEntity);
+        }
+    else
+        {
+        FindFaces(rResult,pEntity,sFaces);
+        if(pEntity->GetType()==SGM::ThingType)
+            {
+            auto sThingReferences=((thing *)pEntity)->GetReferences(true);
+            sReferences.insert(sThingReferences.begin(),sThingReferences.end());
+            }
+        }
+    for(auto pReference : sReferences)
+        {
+        std::set<face *,EntityCompare> sReferencedFaces;
+        FindFaces(rResult,pReference->GetBody(),sReferencedFaces);
+        for(auto pFace : sReferencedFaces)
+            {
+            sFaces.erase(pFace);
+            if(Options.m_b2D==false)
+                {
+                WriteSTLFace(rResult,pFile,pFace,&pReference->GetTransform());
+                }
+            }
+        }
     auto FaceIter=sFaces.begin();
     while(FaceIter!=sFaces.end())
         {
         if(Options.m_b2D==false)
             {
-            face *pFace=*FaceIter;
-            //pFace=(face *)rResult.GetThing()->FindEntity(57);
-            fprintf(pFile,"solid Face %lu\n",pFace->GetID());
-            std::vector<SGM::Point3D> const &aPoints=pFace->GetPoints3D(rResult);
-            std::vector<unsigned int> const &aTriangles=pFace->GetTriangles(rResult);
-            size_t Index1;
-            size_t nTriangles=aTriangles.size();
-            for(Index1=0;Index1<nTriangles;Index1+=3)
-                {
-                unsigned int a=aTriangles[Index1];
-                unsigned int b=aTriangles[Index1+1];
-                unsigned int c=aTriangles[Index1+2];
-                SGM::Point3D const &A=aPoints[a];
-                SGM::Point3D const &B=aPoints[b];
-                SGM::Point3D const &C=aPoints[c];
-                SGM::UnitVector3D Norm=(B-A)*(C-A);
-                fprintf(pFile,"   facet normal %lf %lf %lf\n",Norm.X(),Norm.Y(),Norm.Z());
-                fprintf(pFile,"      outer loop\n");
-                fprintf(pFile,"         vertex %lf %lf %lf\n",A.m_x,A.m_y,A.m_z);
-                fprintf(pFile,"         vertex %lf %lf %lf\n",B.m_x,B.m_y,B.m_z);
-                fprintf(pFile,"         vertex %lf %lf %lf\n",C.m_x,C.m_y,C.m_z);
-                fprintf(pFile,"      endloop\n");
-                fprintf(pFile,"   endfacet\n");
-                }
-            fprintf(pFile,"endsolid Face %lu\n",pFace->GetID());
+            WriteSTLFace(rResult,pFile,*FaceIter,nullptr);
             ++FaceIter;
             }
         else
@@ -5,6 +5,7 @@
 #include "Curve.h"
 #include "EntityClasses.h"
 #include "Surface.h"
+#include "Util/profile.h"
 
 namespace SGMInternal
 {
@@ -58,6 +59,8 @@ void sphere::Evaluate(SGM::Point2D const &uv,
                       SGM::Vector3D      *Duv,
                       SGM::Vector3D      *Dvv) const
     {
+    SGM_PROFILE_COUNT(ProfileSurfaceEvaluate);
+
     double dCosU=cos(uv.m_u);
     double dSinU=sin(uv.m_u);
     double dCosV=cos(uv.m_v);
@@ -112,6 +115,8 @@ SGM::Point2D sphere::Inverse(SGM::Point3D const &Pos,
                               SGM::Point3D       *ClosePos,
                               SGM::Point2D const *pGuess) const
     {
+    SGM_PROFILE_COUNT(ProfileSurfaceInverse);
+
     double x=Pos.m_x-m_Center.m_x;
     double y=Pos.m_y-m_Center.m_y;
     double z=Pos.m_z-m_Center.m_z;
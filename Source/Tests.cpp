@@ -990,6 +990,33 @@ bool RunInternalTest(SGM::Result &rResult,
                 }
             }
 
+        // Consecutive points of a Hilbert ordered grid are neighbors.
+
+        std::vector<SGM::Point3D> aPoints5;
+        for (int i = 0; i < 4; ++i)
+            for (int j = 0; j < 4; ++j)
+                for (int k = 0; k < 4; ++k)
+                    aPoints5.emplace_back(k, j, i);
+        buffer<unsigned> aIndexOrdered5 = SGMInternal::OrderPointsHilbert(aPoints5);
+        for (size_t i = 0; i+1 < aIndexOrdered5.size(); ++i)
+            {
+            double dDist = aPoints5[aIndexOrdered5[i]].Distance(aPoints5[aIndexOrdered5[i+1]]);
+            if (1.001 < dDist)
+                {
+                bAnswer=false;
+                }
+            }
+
+        // Equal points keep their order, including -0.0 and 0.0.
+
+        std::vector<SGM::Point3D> aPoints6 = {{0.0,1.0,0.0},{-0.0,1.0,-0.0},{-1.0,2.0,3.0},{0.0,1.0,0.0}};
+        buffer<unsigned> aIndexOrdered6 = SGMInternal::OrderPointsLexicographical(aPoints6);
+        buffer<unsigned> aExpectedLexicographical6 = { 2, 0, 1, 3 };
+        if (aIndexOrdered6 != aExpectedLexicographical6)
+            {
+            bAnswer=false;
+            }
+
         }
 
     return bAnswer;
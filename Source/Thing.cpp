@@ -5,8 +5,7 @@
 #include "Surface.h"
 #include "Curve.h"
 
-//#define SGM_TIMER
-#include "Util/timer.h"
+#include "Util/profile.h"
 #include "SGMEntityFunctions.h"
 
 #ifdef SGM_MULTITHREADED
@@ -60,6 +59,7 @@ SGM::Interval3D const &thing::GetBox(SGM::Result &rResult,bool /*bContruct*/) co
             auto type = pEntity->GetType();
             // if bounded entity
             if (type == SGM::BodyType ||
+                type == SGM::ReferenceType ||
                 type == SGM::VolumeType ||
                 type == SGM::FaceType ||
                 type == SGM::EdgeType ||
@@ -207,6 +207,13 @@ std::unordered_set<body *> thing::GetBodies(bool bTopLevel) const
     return sBodies;
     }
 
+std::unordered_set<reference *> thing::GetReferences(bool bTopLevel) const
+    {
+    std::unordered_set<reference *> sReferences;
+    GetEntities(SGM::EntityType::ReferenceType, sReferences, bTopLevel);
+    return sReferences;
+    }
+
 std::unordered_set<attribute *> thing::GetAttributes(bool bTopLevel) const
     {
     std::unordered_set<attribute *> sAttribute;
@@ -514,13 +521,12 @@ void RunEntityVisitorJobs(size_t numJobs,
     //
     void thing::FindCachedData(SGM::Result &rResult) const
     {
+        SGM_PROFILE_ZONE("FindCachedData");
 
 #ifdef SGM_MULTITHREADED //////////////////////////////////////////////////////
 
         SetConcurrentActive();
 
-        SGM_TIMER_INITIALIZE();
-
         // may return 0 when not able to detect
         unsigned concurrentThreadsSupported = std::thread::hardware_concurrency();
         concurrentThreadsSupported = std::max((unsigned) 4, concurrentThreadsSupported);
@@ -529,89 +535,79 @@ void RunEntityVisitorJobs(size_t numJobs,
         std::vector<std::future<bool>> futures;
 
         // edges points data
-        SGM_TIMER_START("Edge points");
         {
+            SGM_PROFILE_ZONE("Edge points");
             const size_t NUM_JOBS = 256, NUM_ENTITY_PER_JOB = 64;
             auto iter = Begin<edge*>(), end = End<edge*>();
             EdgePointsVisitor edgeDataVisitor(rResult);
             RunEntityVisitorJobs(NUM_JOBS, NUM_ENTITY_PER_JOB, iter, end, threadPool, futures, edgeDataVisitor);
         }
-        SGM_TIMER_STOP();
 
         // surfaces points data
-        SGM_TIMER_START("Surface points");
         {
+            SGM_PROFILE_ZONE("Surface points");
             const size_t NUM_JOBS = 64, NUM_ENTITY_PER_JOB = 32;
             auto iter = Begin<surface*>(), end = End<surface*>();
             SurfacePointsVisitor surfaceDataVisitor;
             RunEntityVisitorJobs(NUM_JOBS, NUM_ENTITY_PER_JOB, iter, end, threadPool, futures, surfaceDataVisitor);
         }
-        SGM_TIMER_STOP();
 
         // edges box data
-        SGM_TIMER_START("Edge points");
         {
+            SGM_PROFILE_ZONE("Edge boxes");
             const size_t NUM_JOBS = 16, NUM_ENTITY_PER_JOB = 1024;
             auto iter = Begin<edge*>(), end = End<edge*>();
             EdgeBoxVisitor edgeBoxVisitor(rResult);
             RunEntityVisitorJobs(NUM_JOBS, NUM_ENTITY_PER_JOB, iter, end, threadPool, futures, edgeBoxVisitor);
         }
-        SGM_TIMER_STOP();
 
         // faces points data
-        SGM_TIMER_START("Face points");
         {
+            SGM_PROFILE_ZONE("Face points");
             const size_t NUM_JOBS = 512, NUM_ENTITY_PER_JOB = 4;
             auto iter = Begin<face*>(), end = End<face*>();
             FacePointsVisitor faceDataVisitor(rResult);
             RunEntityVisitorJobs(NUM_JOBS, NUM_ENTITY_PER_JOB, iter, end, threadPool, futures, faceDataVisitor);
         }
-        SGM_TIMER_STOP();
 
         // complexes box data
-        SGM_TIMER_START("Complex boxes");
         {
+            SGM_PROFILE_ZONE("Complex boxes");
             const size_t NUM_JOBS = 64, NUM_ENTITY_PER_JOB = 1;
             auto iter = Begin<complex*>(), end = End<complex*>();
             ComplexBoxVisitor complexBoxVisitor(rResult);
             RunEntityVisitorJobs(NUM_JOBS, NUM_ENTITY_PER_JOB, iter, end, threadPool, futures, complexBoxVisitor);
         }
-        SGM_TIMER_STOP();
 
         // faces box data
-        SGM_TIMER_START("Face boxes");
         {
+            SGM_PROFILE_ZONE("Face boxes");
             const size_t NUM_JOBS = 64, NUM_ENTITY_PER_JOB = 32;
             auto iter = Begin<face*>(), end = End<face*>();
             FaceBoxVisitor faceBoxVisitor(rResult);
             RunEntityVisitorJobs(NUM_JOBS, NUM_ENTITY_PER_JOB, iter, end, threadPool, futures, faceBoxVisitor);
         }
-        SGM_TIMER_STOP();
 
         // volumes box data
-        SGM_TIMER_START("Volume boxes");
         {
+            SGM_PROFILE_ZONE("Volume boxes");
             const size_t NUM_JOBS = 64, NUM_ENTITY_PER_JOB = 1;
             auto iter = Begin<volume*>(), end = End<volume*>();
             VolumeBoxVisitor volumeBoxVisitor(rResult);
             RunEntityVisitorJobs(NUM_JOBS, NUM_ENTITY_PER_JOB, iter, end, threadPool, futures, volumeBoxVisitor);
         }
-        SGM_TIMER_STOP();
 
         // faces facet trees
-        SGM_TIMER_START("Face facet trees");
         {
+            SGM_PROFILE_ZONE("Face facet trees");
             const size_t NUM_JOBS = 512, NUM_ENTITY_PER_JOB = 4;
             auto iter = Begin<face*>(), end = End<face*>();
             FaceFacetTreeVisitor faceFacetTreeVisitor(rResult);
             RunEntityVisitorJobs(NUM_JOBS, NUM_ENTITY_PER_JOB, iter, end, threadPool, futures, faceFacetTreeVisitor);
         }
-        SGM_TIMER_STOP();
 
         SetConcurrentInactive();
 
-        SGM_TIMER_SUM();
-
 #else  // NOT SGM_MULTITHREADED ///////////////////////////////////////////////
 
         // edges points data
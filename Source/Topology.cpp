@@ -46,6 +46,13 @@ void FindBodies(SGM::Result                    &,//rResult,
         {
         sBodies.insert((body *)(pEntity));
         }
+    else if(Type==SGM::EntityType::ReferenceType)
+        {
+        if(body *pBody=((reference *)(pEntity))->GetBody())
+            {
+            sBodies.insert(pBody);
+            }
+        }
     else if(Type==SGM::EntityType::VolumeType)
         {
         if(body *pBody=((volume *)(pEntity))->GetBody())
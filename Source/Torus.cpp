@@ -7,6 +7,7 @@
 #include "Curve.h"
 #include "Surface.h"
 #include <cmath>
+#include "Util/profile.h"
 
 namespace SGMInternal
 {
@@ -97,6 +98,8 @@ void torus::Evaluate(SGM::Point2D const &uv,
                      SGM::Vector3D      *Duv,
                      SGM::Vector3D      *Dvv) const
     {
+    SGM_PROFILE_COUNT(ProfileSurfaceEvaluate);
+
     double du=uv.m_u;
     if(m_nKind==SGM::TorusKindType::LemonType)
         {
@@ -173,6 +176,8 @@ SGM::Point2D torus::Inverse(SGM::Point3D const &Pos,
                             SGM::Point3D       *ClosePos,
                             SGM::Point2D const *pGuess) const
     {
+    SGM_PROFILE_COUNT(ProfileSurfaceInverse);
+
     // Find the u value.
 
     double x=Pos.m_x-m_Center.m_x;
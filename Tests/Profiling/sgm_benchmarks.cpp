@@ -0,0 +1,548 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Benchmark suite over the bundled test models.
+//
+//  sgm_benchmarks [--out results.json]
+//                 [--baseline baseline.json] [--tolerance 0.15]
+//                 [--repeat 5] [--filter substring] [--data TestsDirectory]
+//
+// Each scenario is run --repeat times on a fresh thing and the minimum,
+// median and mean wall clock times are written as JSON.  All random inputs
+// use a fixed seed so that runs are comparable.  With --baseline, the
+// medians are compared to those in a JSON file written by an earlier run,
+// and any scenario that is slower by more than the tolerance fraction (and
+// by more than a millisecond) is reported.  The exit code is 1 if any
+// regression is found, 2 for bad arguments.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <random>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#ifdef _MSC_VER
+#include <Windows.h>
+#else
+#include <dirent.h>
+#endif
+
+#include "SGMVector.h"
+#include "SGMEntityClasses.h"
+#include "SGMPrimitives.h"
+#include "SGMTopology.h"
+#include "SGMDisplay.h"
+#include "SGMInterrogate.h"
+#include "SGMIntersector.h"
+#include "SGMModify.h"
+#include "SGMTranslators.h"
+
+#include "EntityClasses.h"
+
+#if !defined(SGM_TESTS_DIRECTORY)
+#error Path to the Tests directory is undefined.
+#endif
+
+namespace
+{
+
+struct BenchmarkResult
+    {
+    std::string m_sName;
+    size_t      m_nItems;   // number of files, rays, points, etc. per run
+    double      m_dMin;     // seconds
+    double      m_dMedian;  // seconds
+    double      m_dMean;    // seconds
+    bool        m_bOK;      // false if any run set an error in the Result
+    };
+
+struct BenchmarkOptions
+    {
+    BenchmarkOptions() :
+        m_sTestsDirectory(SGM_TESTS_DIRECTORY),
+        m_dTolerance(0.15),
+        m_nRepeat(5)
+        {}
+
+    std::string m_sTestsDirectory;
+    std::string m_sOutput;
+    std::string m_sBaseline;
+    std::string m_sFilter;
+    double      m_dTolerance;
+    size_t      m_nRepeat;
+    };
+
+// A scenario is given a new thing on each run.  The setup function builds
+// any input that should not be timed and returns the timed function.
+
+typedef std::function<void (SGM::Result &)> TimedFunction;
+typedef std::function<TimedFunction (SGM::Result &)> SetupFunction;
+
+std::vector<std::string> FindFiles(std::string const &sDirectory,
+                                   std::string const &sExtension)
+    {
+    std::vector<std::string> aNames;
+#ifdef _MSC_VER
+    std::string sSearch=sDirectory+"/*"+sExtension;
+    WIN32_FIND_DATA FindData;
+    HANDLE hFind=::FindFirstFile(sSearch.c_str(),&FindData);
+    if(hFind!=INVALID_HANDLE_VALUE)
+        {
+        do
+            {
+            if(!(FindData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY))
+                {
+                aNames.push_back(sDirectory+"/"+FindData.cFileName);
+                }
+            }
+        while(::FindNextFile(hFind,&FindData));
+        ::FindClose(hFind);
+        }
+#else
+    if(DIR *pDir=opendir(sDirectory.c_str()))
+        {
+        while(struct dirent *pEntry=readdir(pDir))
+            {
+            std::string sName(pEntry->d_name);
+            if(sExtension.size()<sName.size() &&
+               sName.compare(sName.size()-sExtension.size(),sExtension.size(),sExtension)==0)
+                {
+                aNames.push_back(sDirectory+"/"+sName);
+                }
+            }
+        closedir(pDir);
+        }
+#endif
+    // Directory order is not stable across systems.
+    std::sort(aNames.begin(),aNames.end());
+    return aNames;
+    }
+
+size_t ReadFiles(SGM::Result                    &rResult,
+                 std::vector<std::string> const &aFiles)
+    {
+    SGM::TranslatorOptions Options;
+    size_t nEntities=0;
+    for(auto const &sFile : aFiles)
+        {
+        std::vector<SGM::Entity> aEntities;
+        std::vector<std::string> aLog;
+        nEntities+=SGM::ReadFile(rResult,sFile,aEntities,aLog,Options);
+        }
+    return nEntities;
+    }
+
+std::vector<SGM::Point3D> RandomPoints(SGM::Interval3D const &Box,
+                                       size_t                 nPoints)
+    {
+    std::mt19937 Generator(5489U);
+    std::uniform_real_distribution<double> Unit(0.0,1.0);
+    std::vector<SGM::Point3D> aPoints;
+    aPoints.reserve(nPoints);
+    for(size_t Index1=0;Index1<nPoints;++Index1)
+        {
+        double x=Box.m_XDomain.MidPoint(Unit(Generator));
+        double y=Box.m_YDomain.MidPoint(Unit(Generator));
+        double z=Box.m_ZDomain.MidPoint(Unit(Generator));
+        aPoints.emplace_back(x,y,z);
+        }
+    return aPoints;
+    }
+
+BenchmarkResult RunBenchmark(std::string      const &sName,
+                             size_t                  nItems,
+                             BenchmarkOptions const &Options,
+                             SetupFunction    const &Setup)
+    {
+    BenchmarkResult Answer{sName,nItems,0.0,0.0,0.0,true};
+    std::vector<double> aTimes;
+    for(size_t nRun=0;nRun<Options.m_nRepeat;++nRun)
+        {
+        SGMInternal::thing *pThing=SGM::CreateThing();
+        SGM::Result rResult(pThing);
+        auto Start=std::chrono::steady_clock::now();
+        try
+            {
+            TimedFunction Timed=Setup(rResult);
+            Start=std::chrono::steady_clock::now();
+            Timed(rResult);
+            }
+        catch(std::exception const &Error)
+            {
+            std::cerr << sName << ": " << Error.what() << std::endl;
+            Answer.m_bOK=false;
+            }
+        auto Stop=std::chrono::steady_clock::now();
+        aTimes.push_back(std::chrono::duration<double>(Stop-Start).count());
+        if(rResult.GetResult()!=SGM::ResultTypeOK)
+            {
+            Answer.m_bOK=false;
+            }
+        SGM::DeleteThing(pThing);
+        }
+    std::sort(aTimes.begin(),aTimes.end());
+    size_t nTimes=aTimes.size();
+    Answer.m_dMin=aTimes.front();
+    Answer.m_dMedian=nTimes%2 ? aTimes[nTimes/2] : 0.5*(aTimes[nTimes/2-1]+aTimes[nTimes/2]);
+    double dSum=0.0;
+    for(double dTime : aTimes)
+        {
+        dSum+=dTime;
+        }
+    Answer.m_dMean=dSum/nTimes;
+    std::cout << sName << " " << Answer.m_dMedian << " s" << (Answer.m_bOK ? "" : " (errors)") << std::endl;
+    return Answer;
+    }
+
+void RunScenarios(BenchmarkOptions       const &Options,
+                  std::vector<BenchmarkResult> &aResults)
+    {
+    std::vector<std::pair<std::string,std::function<BenchmarkResult ()> > > aScenarios;
+
+    std::vector<std::string> aSTEPFiles=FindFiles(Options.m_sTestsDirectory+"/STEP Parts",".stp");
+    std::vector<std::string> aSTLFiles=FindFiles(Options.m_sTestsDirectory+"/STL Parts",".stl");
+
+    // Import scenarios.
+
+    for(auto const &sFile : aSTEPFiles)
+        {
+        std::string sName="ReadSTEP/"+sFile.substr(sFile.rfind('/')+1);
+        aScenarios.emplace_back(sName,[=,&Options]()
+            {
+            return RunBenchmark(sName,1,Options,[=](SGM::Result &)
+                { return [=](SGM::Result &rResult) { ReadFiles(rResult,{sFile}); }; });
+            });
+        }
+    for(auto const &sFile : aSTLFiles)
+        {
+        std::string sName="ReadSTL/"+sFile.substr(sFile.rfind('/')+1);
+        aScenarios.emplace_back(sName,[=,&Options]()
+            {
+            return RunBenchmark(sName,1,Options,[=](SGM::Result &)
+                { return [=](SGM::Result &rResult) { ReadFiles(rResult,{sFile}); }; });
+            });
+        }
+
+    // The whole model scenarios use the STEP parts that can be read.
+
+    std::vector<std::string> aModelFiles;
+    for(auto const &sFile : aSTEPFiles)
+        {
+        SGMInternal::thing *pThing=SGM::CreateThing();
+        SGM::Result rResult(pThing);
+        try
+            {
+            ReadFiles(rResult,{sFile});
+            if(rResult.GetResult()==SGM::ResultTypeOK)
+                {
+                aModelFiles.push_back(sFile);
+                }
+            }
+        catch(std::exception const &)
+            {
+            }
+        SGM::DeleteThing(pThing);
+        }
+
+    // Cached data and faceting of the model.  Clearing the edge facets also
+    // clears the facets, boxes and trees of their faces.
+
+    aScenarios.emplace_back("FindCachedData",[&]()
+        {
+        return RunBenchmark("FindCachedData",aModelFiles.size(),Options,[&](SGM::Result &rResult)
+            {
+            ReadFiles(rResult,aModelFiles);
+            SGMInternal::thing *pThing=rResult.GetThing();
+            for(auto *pEdge : pThing->GetEdges())
+                {
+                pEdge->ClearFacets(rResult);
+                }
+            return [](SGM::Result &rResult) { rResult.GetThing()->FindCachedData(rResult); };
+            });
+        });
+
+    aScenarios.emplace_back("FacetModel",[&]()
+        {
+        return RunBenchmark("FacetModel",aModelFiles.size(),Options,[&](SGM::Result &rResult)
+            {
+            ReadFiles(rResult,aModelFiles);
+            std::vector<SGM::Face> aFaces;
+            for(auto *pFace : rResult.GetThing()->GetFaces())
+                {
+                pFace->ClearFacets(rResult);
+                aFaces.emplace_back(pFace->GetID());
+                }
+            std::sort(aFaces.begin(),aFaces.end());
+            return [=](SGM::Result &rResult)
+                {
+                for(auto const &FaceID : aFaces)
+                    {
+                    SGM::GetFaceTriangles(rResult,FaceID);
+                    }
+                };
+            });
+        });
+
+    // Queries on primitives.
+
+    const size_t nRays=2000;
+    aScenarios.emplace_back("RayFire",[&]()
+        {
+        return RunBenchmark("RayFire",nRays,Options,[&](SGM::Result &rResult)
+            {
+            SGM::Body TorusID=SGM::CreateTorus(rResult,SGM::Point3D(0,0,0),SGM::UnitVector3D(0,0,1),1.0,3.0);
+            std::vector<SGM::Point3D> aOrigins=RandomPoints(SGM::Interval3D(-5,5,-5,5,-5,5),nRays);
+            std::vector<SGM::Point3D> aTargets=RandomPoints(SGM::Interval3D(-4,4,-4,4,-1,1),nRays+1);
+            return [=](SGM::Result &rResult)
+                {
+                std::vector<SGM::Point3D> aPoints;
+                std::vector<SGM::IntersectionType> aTypes;
+                std::vector<SGM::Entity> aEntities;
+                for(size_t Index1=0;Index1<nRays;++Index1)
+                    {
+                    SGM::UnitVector3D Axis=aTargets[Index1+1]-aOrigins[Index1];
+                    SGM::RayFire(rResult,aOrigins[Index1],Axis,TorusID,aPoints,aTypes,aEntities);
+                    }
+                };
+            });
+        });
+
+    const size_t nCloud=20000;
+    aScenarios.emplace_back("PointsInVolume",[&]()
+        {
+        return RunBenchmark("PointsInVolume",nCloud,Options,[&](SGM::Result &rResult)
+            {
+            SGM::Body SphereID=SGM::CreateSphere(rResult,SGM::Point3D(0,0,0),2.0);
+            std::set<SGM::Volume> sVolumes;
+            SGM::FindVolumes(rResult,SphereID,sVolumes);
+            SGM::Volume VolumeID=*sVolumes.begin();
+            std::vector<SGM::Point3D> aPoints=RandomPoints(SGM::Interval3D(-3,3,-3,3,-3,3),nCloud);
+            return [=](SGM::Result &rResult) { SGM::PointsInVolume(rResult,aPoints,VolumeID); };
+            });
+        });
+
+    // Booleans on blocks, as in the boolean tests.
+
+    aScenarios.emplace_back("UniteBodies",[&]()
+        {
+        return RunBenchmark("UniteBodies",1,Options,[](SGM::Result &rResult)
+            {
+            SGM::Body BlockID1=SGM::CreateBlock(rResult,SGM::Point3D(0,0,0),SGM::Point3D(10,10,10));
+            SGM::Body BlockID2=SGM::CreateBlock(rResult,SGM::Point3D(5,5,5),SGM::Point3D(15,15,15));
+            return [=](SGM::Result &rResult) mutable { SGM::UniteBodies(rResult,BlockID1,BlockID2); };
+            });
+        });
+
+    aScenarios.emplace_back("SubtractBodies",[&]()
+        {
+        return RunBenchmark("SubtractBodies",1,Options,[](SGM::Result &rResult)
+            {
+            SGM::Body BlockID1=SGM::CreateBlock(rResult,SGM::Point3D(0,0,0),SGM::Point3D(10,10,10));
+            SGM::Body BlockID2=SGM::CreateBlock(rResult,SGM::Point3D(5,5,5),SGM::Point3D(15,15,15));
+            return [=](SGM::Result &rResult) mutable { SGM::SubtractBodies(rResult,BlockID1,BlockID2); };
+            });
+        });
+
+    // SGM file round trip of the model.
+
+    aScenarios.emplace_back("SGMRoundTrip",[&]()
+        {
+        return RunBenchmark("SGMRoundTrip",aModelFiles.size(),Options,[&](SGM::Result &rResult)
+            {
+            ReadFiles(rResult,aModelFiles);
+            return [](SGM::Result &rResult)
+                {
+                std::string sFile("sgm_benchmarks_round_trip.sgm");
+                SGM::TranslatorOptions TranslatorOptions;
+                SGM::SaveSGM(rResult,sFile,SGM::Thing(),TranslatorOptions);
+                SGMInternal::thing *pThing=SGM::CreateThing();
+                SGM::Result rReadResult(pThing);
+                ReadFiles(rReadResult,{sFile});
+                SGM::DeleteThing(pThing);
+                std::remove(sFile.c_str());
+                };
+            });
+        });
+
+    for(auto const &Scenario : aScenarios)
+        {
+        if(Scenario.first.find(Options.m_sFilter)!=std::string::npos)
+            {
+            aResults.push_back(Scenario.second());
+            }
+        }
+    }
+
+void WriteJSON(std::ostream                       &Stream,
+               BenchmarkOptions             const &Options,
+               std::vector<BenchmarkResult> const &aResults)
+    {
+    Stream.precision(9);
+    Stream << "{\n  \"repeat\": " << Options.m_nRepeat << ",\n";
+#ifdef SGM_MULTITHREADED
+    Stream << "  \"multithreaded\": true,\n";
+#else
+    Stream << "  \"multithreaded\": false,\n";
+#endif
+    Stream << "  \"benchmarks\": [";
+    for(size_t Index1=0;Index1<aResults.size();++Index1)
+        {
+        BenchmarkResult const &Result=aResults[Index1];
+        Stream << (Index1 ? ",\n" : "\n")
+               << "    {\"name\": \"" << Result.m_sName << "\""
+               << ", \"items\": " << Result.m_nItems
+               << ", \"min\": " << Result.m_dMin
+               << ", \"median\": " << Result.m_dMedian
+               << ", \"mean\": " << Result.m_dMean
+               << ", \"ok\": " << (Result.m_bOK ? "true" : "false") << "}";
+        }
+    Stream << "\n  ]\n}\n";
+    }
+
+// Reads the name and median of each benchmark from a file written by
+// WriteJSON.  This is not a general JSON reader.
+
+bool ReadBaseline(std::string            const &sFileName,
+                  std::map<std::string,double> &mMedians)
+    {
+    std::ifstream File(sFileName);
+    if(!File.good())
+        {
+        return false;
+        }
+    std::string sLine;
+    while(std::getline(File,sLine))
+        {
+        size_t nName=sLine.find("\"name\": \"");
+        size_t nMedian=sLine.find("\"median\": ");
+        if(nName!=std::string::npos && nMedian!=std::string::npos)
+            {
+            nName+=9;
+            std::string sName=sLine.substr(nName,sLine.find('"',nName)-nName);
+            mMedians[sName]=std::strtod(sLine.c_str()+nMedian+10,nullptr);
+            }
+        }
+    return true;
+    }
+
+size_t CompareToBaseline(BenchmarkOptions             const &Options,
+                         std::vector<BenchmarkResult> const &aResults,
+                         std::map<std::string,double> const &mBaseline)
+    {
+    const double dNoise=0.001;
+    size_t nRegressions=0;
+    std::cout << std::endl << "Comparison to " << Options.m_sBaseline << std::endl;
+    for(auto const &Result : aResults)
+        {
+        auto iter=mBaseline.find(Result.m_sName);
+        if(iter==mBaseline.end())
+            {
+            std::cout << "  NEW        " << Result.m_sName << std::endl;
+            continue;
+            }
+        double dBase=iter->second;
+        double dRatio=dBase>0.0 ? Result.m_dMedian/dBase : 1.0;
+        bool bRegression=Result.m_dMedian>dBase*(1.0+Options.m_dTolerance) && Result.m_dMedian-dBase>dNoise;
+        if(bRegression)
+            {
+            ++nRegressions;
+            }
+        std::cout << (bRegression ? "  REGRESSION " : "  ok         ") << Result.m_sName
+                  << " " << dBase << " s -> " << Result.m_dMedian << " s (x" << dRatio << ")" << std::endl;
+        }
+    return nRegressions;
+    }
+
+bool ParseArguments(int               argc,
+                    char            **argv,
+                    BenchmarkOptions &Options)
+    {
+    for(int Index1=1;Index1<argc;++Index1)
+        {
+        std::string sArg(argv[Index1]);
+        if(Index1+1==argc)
+            {
+            return false;
+            }
+        std::string sValue(argv[++Index1]);
+        if(sArg=="--out")
+            {
+            Options.m_sOutput=sValue;
+            }
+        else if(sArg=="--baseline")
+            {
+            Options.m_sBaseline=sValue;
+            }
+        else if(sArg=="--tolerance")
+            {
+            Options.m_dTolerance=std::strtod(sValue.c_str(),nullptr);
+            }
+        else if(sArg=="--repeat")
+            {
+            Options.m_nRepeat=std::max((size_t)1,(size_t)std::strtoul(sValue.c_str(),nullptr,10));
+            }
+        else if(sArg=="--filter")
+            {
+            Options.m_sFilter=sValue;
+            }
+        else if(sArg=="--data")
+            {
+            Options.m_sTestsDirectory=sValue;
+            }
+        else
+            {
+            return false;
+            }
+        }
+    return true;
+    }
+
+} // anonymous namespace
+
+int main(int argc, char **argv)
+    {
+    BenchmarkOptions Options;
+    if(!ParseArguments(argc,argv,Options))
+        {
+        std::cerr << "usage: sgm_benchmarks [--out file.json] [--baseline file.json] [--tolerance fraction]"
+                     " [--repeat count] [--filter substring] [--data TestsDirectory]" << std::endl;
+        return 2;
+        }
+
+    std::map<std::string,double> mBaseline;
+    if(!Options.m_sBaseline.empty() && !ReadBaseline(Options.m_sBaseline,mBaseline))
+        {
+        std::cerr << "cannot read baseline " << Options.m_sBaseline << std::endl;
+        return 2;
+        }
+
+    std::vector<BenchmarkResult> aResults;
+    RunScenarios(Options,aResults);
+
+    if(Options.m_sOutput.empty())
+        {
+        WriteJSON(std::cout,Options,aResults);
+        }
+    else
+        {
+        std::ofstream File(Options.m_sOutput);
+        WriteJSON(File,Options,aResults);
+        }
+
+    if(!Options.m_sBaseline.empty() && CompareToBaseline(Options,aResults,mBaseline))
+        {
+        return 1;
+        }
+    return 0;
+    }
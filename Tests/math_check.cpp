@@ -1739,6 +1739,53 @@ TEST(math_check, triangulate_polygon_with_holes)
     SGMTesting::ReleaseTestThing(pThing);
     }
 
+TEST(math_check, triangulate_large_polygon)
+    {
+    SGMInternal::thing *pThing = SGMTesting::AcquireTestThing();
+    SGM::Result rResult(pThing);
+
+    // A star shaped polygon with many reflex vertices and a hole.
+
+    std::vector<SGM::Point2D> aPoints2D;
+    std::vector<unsigned> aOutside,aInside;
+    unsigned nPoints=4000;
+    unsigned Index1;
+    for(Index1=0;Index1<nPoints;++Index1)
+        {
+        double dAngle=SGM_TWO_PI*Index1/nPoints;
+        double dRadius=Index1%2 ? 10.0 : 9.0;
+        aPoints2D.emplace_back(dRadius*cos(dAngle),dRadius*sin(dAngle));
+        aOutside.push_back(Index1);
+        }
+    for(Index1=0;Index1<100;++Index1)
+        {
+        double dAngle=-SGM_TWO_PI*Index1/100;
+        aPoints2D.emplace_back(cos(dAngle),sin(dAngle));
+        aInside.push_back(nPoints+Index1);
+        }
+    std::vector<std::vector<unsigned>> aaPolygons = {aOutside,aInside};
+    std::vector<unsigned> aTriangles,aAdjacencies;
+    EXPECT_TRUE(SGM::TriangulatePolygonWithHoles(rResult,aPoints2D,aaPolygons,aTriangles,aAdjacencies,false));
+    EXPECT_EQ(aTriangles.size(),3U*(nPoints+100));
+
+    double dArea=0;
+    size_t nTriangles=aTriangles.size();
+    for(size_t Index2=0;Index2<nTriangles;Index2+=3)
+        {
+        SGM::Point2D const &A=aPoints2D[aTriangles[Index2]];
+        SGM::Point2D const &B=aPoints2D[aTriangles[Index2+1]];
+        SGM::Point2D const &C=aPoints2D[aTriangles[Index2+2]];
+        double dTriangleArea=((B.m_u-A.m_u)*(C.m_v-A.m_v)-(C.m_u-A.m_u)*(B.m_v-A.m_v))*0.5;
+        EXPECT_GT(dTriangleArea,0.0);
+        dArea+=dTriangleArea;
+        }
+    double dExpected=SGM::PolygonArea(SGM::PointsFromPolygon2D(aPoints2D,aOutside))+
+                     SGM::PolygonArea(SGM::PointsFromPolygon2D(aPoints2D,aInside));
+    EXPECT_NEAR(dArea,dExpected,SGM_MIN_TOL);
+
+    SGMTesting::ReleaseTestThing(pThing);
+    }
+
 TEST(math_check, triangulate_polygon)
     {
     SGMInternal::thing *pThing = SGMTesting::AcquireTestThing();
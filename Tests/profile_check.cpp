@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+#include "SGMVector.h"
+#include "SGMEntityFunctions.h"
+#include "SGMPrimitives.h"
+#include "SGMTopology.h"
+#include "SGMDisplay.h"
+#include "SGMProfile.h"
+
+#include "test_utility.h"
+
+#ifdef __clang__
+#pragma clang diagnostic push
+#pragma ide diagnostic ignored "cert-err58-cpp"
+#endif
+
+TEST(profile_check, profile_counts_and_trace)
+{
+    SGMInternal::thing *pThing = SGMTesting::AcquireTestThing();
+    SGM::Result rResult(pThing);
+
+    SGM::ClearProfile(rResult);
+    rResult.SetProfiling(true);
+    EXPECT_TRUE(rResult.GetProfiling());
+
+    SGM::Body SphereID = SGM::CreateSphere(rResult, SGM::Point3D(0,0,0), 1.0);
+    std::set<SGM::Face> sFaces;
+    SGM::FindFaces(rResult, SphereID, sFaces);
+    for (auto const &FaceID : sFaces)
+        {
+        SGM::GetFaceTriangles(rResult, FaceID);
+        }
+
+    rResult.SetProfiling(false);
+    EXPECT_FALSE(rResult.GetProfiling());
+
+    std::map<std::string,size_t> mCounts = SGM::GetProfileCounts(rResult);
+    EXPECT_GT(mCounts["SurfaceEvaluate"], 0U);
+    EXPECT_GT(mCounts["FacetFace"], 0U);
+
+    // Nothing is recorded while profiling is off.
+
+    size_t nFacetFace = mCounts["FacetFace"];
+    SGM::Body SphereID2 = SGM::CreateSphere(rResult, SGM::Point3D(3,0,0), 1.0);
+    SGM::FindFaces(rResult, SphereID2, sFaces);
+    for (auto const &FaceID : sFaces)
+        {
+        SGM::GetFaceTriangles(rResult, FaceID);
+        }
+    EXPECT_EQ(SGM::GetProfileCounts(rResult)["FacetFace"], nFacetFace);
+
+    std::string sSummary = SGM::GetProfileSummary(rResult);
+    EXPECT_NE(sSummary.find("FacetFace"), std::string::npos);
+
+    std::string sFileName("profile_check_trace.json");
+    EXPECT_TRUE(SGM::WriteProfileTrace(rResult, sFileName));
+    std::ifstream TraceFile(sFileName);
+    std::stringstream Buffer;
+    Buffer << TraceFile.rdbuf();
+    TraceFile.close();
+    EXPECT_NE(Buffer.str().find("\"traceEvents\""), std::string::npos);
+    std::remove(sFileName.c_str());
+
+    EXPECT_FALSE(SGM::WriteProfileTrace(rResult, "no_such_directory/trace.json"));
+    EXPECT_EQ(rResult.GetResult(), SGM::ResultTypeFileOpen);
+    rResult.ClearMessage();
+
+    SGM::ClearProfile(rResult);
+    EXPECT_EQ(SGM::GetProfileCounts(rResult)["FacetFace"], 0U);
+
+    SGMTesting::ReleaseTestThing(pThing);
+}
+
+#ifdef __clang__
+#pragma clang diagnostic pop
+#endif
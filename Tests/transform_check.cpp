@@ -5,6 +5,9 @@
 #include "SGMEntityClasses.h"
 #include "SGMTransform.h"
 #include "SGMPrimitives.h"
+#include "SGMInterrogate.h"
+#include "SGMIntersector.h"
+#include "SGMTopology.h"
 
 #include "test_utility.h"
 
@@ -88,6 +91,77 @@ TEST(transform_check, translate_thing)
     SGMTesting::ReleaseTestThing(pThing);
 }
 
+TEST(transform_check, reference_instances)
+{
+    SGMInternal::thing *pThing = SGMTesting::AcquireTestThing();
+    SGM::Result rResult(pThing);
+
+    SGM::Thing ThingID;
+
+    SGM::Body Block = SGM::CreateBlock(rResult, SGM::Point3D(0.,0.,0.), SGM::Point3D(1.,1.,1.));
+
+    // one instance moved along X, one turned a quarter about Z and moved along Y
+
+    SGM::Transform3D Trans1(SGM::Vector3D(5.,0.,0.));
+    SGM::Reference Reference1 = SGM::CreateReference(rResult, Block, Trans1);
+
+    SGM::Transform3D Rotate;
+    SGM::Rotate(SGM::Point3D(0.,0.,0.), SGM::UnitVector3D(0.,0.,1.), SGM_HALF_PI, Rotate);
+    SGM::Transform3D Trans2 = Rotate * SGM::Transform3D(SGM::Vector3D(0.,5.,0.));
+    SGM::Reference Reference2 = SGM::CreateReference(rResult, Block, Trans2);
+
+    SGM::Transform3D Placement;
+    EXPECT_EQ(SGM::GetReferenceBody(rResult, Reference1, Placement).m_ID, Block.m_ID);
+    EXPECT_TRUE(SGMTesting::CheckEntityAndPrintLog(rResult, Reference1));
+
+    SGM::Interval3D Box1 = SGM::GetBoundingBox(rResult, Reference1);
+    EXPECT_TRUE(SGM::NearEqual(Box1.MidPoint(), SGM::Point3D(5.5,.5,.5), SGM_MIN_TOL));
+    SGM::Interval3D Box2 = SGM::GetBoundingBox(rResult, Reference2);
+    EXPECT_TRUE(SGM::NearEqual(Box2.MidPoint(), SGM::Point3D(-.5,5.5,.5), SGM_MIN_TOL));
+
+    // the block itself is only seen through its references
+
+    SGM::Interval3D ThingBox = SGM::GetBoundingBox(rResult, ThingID);
+    EXPECT_NEAR(ThingBox.m_XDomain.m_dMin, -1.0, SGM_MIN_TOL);
+    EXPECT_NEAR(ThingBox.m_XDomain.m_dMax, 6.0, SGM_MIN_TOL);
+    EXPECT_NEAR(ThingBox.m_YDomain.m_dMin, 0.0, SGM_MIN_TOL);
+
+    EXPECT_TRUE(SGM::PointInEntity(rResult, SGM::Point3D(5.5,.5,.5), Reference1));
+    EXPECT_FALSE(SGM::PointInEntity(rResult, SGM::Point3D(.5,.5,.5), Reference1));
+    EXPECT_TRUE(SGM::PointInEntity(rResult, SGM::Point3D(-.5,5.5,.5), Reference2));
+
+    std::vector<SGM::Point3D> aPoints;
+    std::vector<SGM::IntersectionType> aTypes;
+    std::vector<SGM::Entity> aEntities;
+    size_t nHits = SGM::RayFire(rResult, SGM::Point3D(-10.,.5,.5), SGM::UnitVector3D(1.,0.,0.),
+                                ThingID, aPoints, aTypes, aEntities);
+    ASSERT_EQ(nHits, 2U);
+    EXPECT_NEAR(aPoints[0].m_x, 5.0, SGM_MIN_TOL);
+    EXPECT_NEAR(aPoints[1].m_x, 6.0, SGM_MIN_TOL);
+
+    // moving a reference does not move the shared block
+
+    SGM::Entity Moved = Reference1;
+    SGM::TransformEntity(rResult, SGM::Transform3D(SGM::Vector3D(0.,0.,2.)), Moved);
+    EXPECT_TRUE(SGM::PointInEntity(rResult, SGM::Point3D(5.5,.5,2.5), Reference1));
+    EXPECT_TRUE(SGM::PointInEntity(rResult, SGM::Point3D(-.5,5.5,.5), Reference2));
+
+    // the block is deleted with its last reference
+
+    SGM::DeleteEntity(rResult, Moved);
+    std::set<SGM::Body> sBodies;
+    SGM::FindBodies(rResult, ThingID, sBodies, false);
+    EXPECT_EQ(sBodies.size(), 1U);
+
+    SGM::Entity Last = Reference2;
+    SGM::DeleteEntity(rResult, Last);
+    sBodies.clear();
+    SGM::FindBodies(rResult, ThingID, sBodies, false);
+    EXPECT_TRUE(sBodies.empty());
+
+    SGMTesting::ReleaseTestThing(pThing);
+}
+
 #ifdef __clang__
 #pragma clang diagnostic pop
 #endif
@@ -8,6 +8,7 @@
 #include "SGMInterval.h"
 #include "SGMPrimitives.h"
 #include "SGMMeasure.h"
+#include "SGMChecker.h"
 
 #include "test_utility.h"
 
@@ -101,6 +102,57 @@ TEST(volume_check, torus)
     SGMTesting::ReleaseTestThing(pThing);
     }
 
+TEST(volume_check, check_thing_levels)
+{
+    SGMInternal::thing *pThing = SGMTesting::AcquireTestThing();
+    SGM::Result rResult(pThing);
+
+    // Enough entities to be checked in parallel when SGM_MULTITHREADED is on.
+
+    std::vector<SGM::Body> aBlocks;
+    for (int Index1 = 0; Index1 < 12; ++Index1)
+        {
+        SGM::Point3D Pos0(3.0*Index1,0,0),Pos1(3.0*Index1+2.0,1,1);
+        aBlocks.push_back(SGM::CreateBlock(rResult,Pos0,Pos1));
+        }
+
+    SGM::CheckOptions Options;
+    Options.m_bOverlappingEdges = true;
+    std::vector<std::string> aCheckStrings;
+    EXPECT_TRUE(SGM::CheckEntity(rResult,SGM::Thing(),Options,aCheckStrings));
+    EXPECT_TRUE(aCheckStrings.empty());
+
+    Options.m_nLevel = SGM::CheckStructureLevel;
+    EXPECT_TRUE(SGM::CheckEntity(rResult,aBlocks[0],Options,aCheckStrings));
+    EXPECT_TRUE(aCheckStrings.empty());
+
+    // Check strings are in the order of entity IDs.
+
+    SGM::Body SheetID=SGM::CreateDisk(rResult,SGM::Point3D(0,0,5),SGM::UnitVector3D(0,0,1),1.0);
+    SGM::Body SheetID2=SGM::CreateDisk(rResult,SGM::Point3D(0,0,8),SGM::UnitVector3D(0,0,1),1.0);
+    SGMInternal::body *pBody1=(SGMInternal::body *)pThing->FindEntity(SheetID.m_ID);
+    SGMInternal::body *pBody2=(SGMInternal::body *)pThing->FindEntity(SheetID2.m_ID);
+    auto *pVolume1=*pBody1->GetVolumes().begin();
+    auto *pVolume2=*pBody2->GetVolumes().begin();
+    pBody1->RemoveVolume(pVolume1);
+    pBody2->RemoveVolume(pVolume2);
+    aCheckStrings.clear();
+    EXPECT_FALSE(SGM::CheckEntity(rResult,SGM::Thing(),Options,aCheckStrings));
+    std::vector<std::string> aEmptyBodies;
+    for (auto const &sCheck : aCheckStrings)
+        {
+        if (sCheck.find(" has no volumes") != std::string::npos)
+            aEmptyBodies.push_back(sCheck);
+        }
+    ASSERT_EQ(aEmptyBodies.size(),2U);
+    EXPECT_NE(aEmptyBodies[0].find(" "+std::to_string(SheetID.m_ID)+" has no volumes"),std::string::npos);
+    EXPECT_NE(aEmptyBodies[1].find(" "+std::to_string(SheetID2.m_ID)+" has no volumes"),std::string::npos);
+    pBody1->AddVolume(pVolume1);
+    pBody2->AddVolume(pVolume2);
+
+    SGMTesting::ReleaseTestThing(pThing);
+}
+
 TEST(volume_check, body_volumes)
     {
     SGMInternal::thing *pThing = SGMTesting::AcquireTestThing();